@@ -1,7 +1,9 @@
 #!/bin/sh
 
 options="default check debug symbols"
-options="$options nosort noblock nolearn noreduce norestart nomode"
+options="$options nosort noblock noblocked nolearn noreduce norestart nomode"
+options="$options notransitive nobumpreasons nosubsume"
+options="$options nostrengthen nocompact nopipeline packed compress"
 
 failed () {
   echo
@@ -28,6 +30,9 @@ filter () {
   case $1$2 in
     nolearnnoreduce) return 0;;
     norestartnomode) return 0;;
+    nolearnnosubsume) return 0;;
+    nolearncompress) return 0;;
+    noreducecompress) return 0;;
     *) return 1;;
   esac
 }
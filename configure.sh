@@ -10,13 +10,22 @@ where '<option>' is one of the following:
 -g | --debug      include symbol table, logging and internal checking code
 -c | --check      include internal checking code (forced by '-g')
 -s | --symbols    include symbol table (forced by '-g')
+-p | --packed     pack assignment into two bits per variable
+--compress        compress long learned clauses
                  
 --no-block        disable blocking literals (thus slower propagation)
+--no-blocked      disable blocked and covered clause elimination
+--no-bumpreasons  disable bumping reason side literals
+--no-compact      disable compacting and renumbering variables
 --no-learn        disable clause learning (do not add learned clauses)
 --no-mode         disable switching between focused and stable mode
+--no-pipeline     disable parsing in a separate producer thread
 --no-reduce       disable clause reduction (keep learned clauses forever)
 --no-restart      disable restarting (otherwise moving average based)
 --no-sort         disable sorting of bumped literals
+--no-strengthen   disable on-the-fly strengthening of reasons
+--no-subsume      disable eager subsumption of learned clauses
+--no-transitive   disable transitive reduction of binary clauses
 EOF
 }
 
@@ -28,14 +37,23 @@ die () {
 debug=no
 check=no
 symbols=no
+packed=no
+compress=no
 
 block=yes
+blocked=yes
+bumpreasons=yes
+compact=yes
 learn=yes
 minimize=yes
 mode=yes
+pipeline=yes
 reduce=yes
 restart=yes
 sort=yes
+strengthen=yes
+subsume=yes
+transitive=yes
 
 options=""
 
@@ -47,13 +65,22 @@ do
     -g|--debug) debug=yes;;
     -c|--check) check=yes;;
     -s|--symbols) symbols=yes;;
+    -p|--packed) packed=yes;;
+    --compress) compress=yes;;
     --no-block) block=no;;
+    --no-blocked) blocked=no;;
+    --no-bumpreasons) bumpreasons=no;;
+    --no-compact) compact=no;;
     --no-minimize) minimize=no;;
     --no-mode) mode=no;;
     --no-learn) learn=no;;
+    --no-pipeline) pipeline=no;;
     --no-reduce) reduce=no;;
     --no-restart) restart=no;;
     --no-sort) sort=no;;
+    --no-strengthen) strengthen=no;;
+    --no-subsume) subsume=no;;
+    --no-transitive) transitive=no;;
     -f*) options="$options $1";;
     *) die "invalid option '$1' (try '-h')";;
   esac
@@ -69,6 +96,15 @@ die "'--no-learn' implies '--no-reduce'"
 [ $learn = no -a $minimize = no ] && \
   die "'--no-learn' implies '--no-minimize'"
 
+[ $learn = no -a $subsume = no ] && \
+  die "'--no-learn' implies '--no-subsume'"
+
+[ $compress = yes -a $reduce = no ] && \
+  die "'--compress' requires clause reduction"
+
+[ $compress = yes -a $learn = no ] && \
+  die "'--compress' requires clause learning"
+
 CC=gcc
 
 CFLAGS="-Wall"
@@ -84,15 +120,25 @@ fi
 # didactic purposes in order to show the effect of certain ideas.
 
 [ $symbols = yes ] && CFLAGS="$CFLAGS -ggdb3"
+[ $packed = yes ] && CFLAGS="$CFLAGS -DPACKED"
+[ $compress = yes ] && CFLAGS="$CFLAGS -DCOMPRESS"
+[ $pipeline = yes ] && CFLAGS="$CFLAGS -pthread"
 CFLAGS="$CFLAGS$options"
 [ $block = no ] && CFLAGS="$CFLAGS -DNBLOCK"
+[ $blocked = no ] && CFLAGS="$CFLAGS -DNBLOCKED"
+[ $bumpreasons = no ] && CFLAGS="$CFLAGS -DNBUMPREASONS"
 [ $check = no ] && CFLAGS="$CFLAGS -DNDEBUG"
+[ $compact = no ] && CFLAGS="$CFLAGS -DNCOMPACT"
 [ $learn = no ] && CFLAGS="$CFLAGS -DNLEARN"
 [ $minimize = no ] && CFLAGS="$CFLAGS -DNMINIMIZE"
 [ $mode = no ] && CFLAGS="$CFLAGS -DNMODE"
+[ $pipeline = no ] && CFLAGS="$CFLAGS -DNPIPELINE"
 [ $reduce = no ] && CFLAGS="$CFLAGS -DNREDUCE"
 [ $restart = no ] && CFLAGS="$CFLAGS -DNRESTART"
 [ $sort = no ] && CFLAGS="$CFLAGS -DNSORT"
+[ $strengthen = no ] && CFLAGS="$CFLAGS -DNSTRENGTHEN"
+[ $subsume = no ] && CFLAGS="$CFLAGS -DNSUBSUME"
+[ $transitive = no ] && CFLAGS="$CFLAGS -DNTRANSITIVE"
 
 COMPILE="$CC $CFLAGS"
 echo "$COMPILE"
@@ -27,6 +27,14 @@ static const char *usage =
 #ifndef NDEBUG
 "  -l | --log           enable logging messages\n"
 #endif
+"  --features=<file>    write instance features in JSON format\n"
+"\n"
+"or one of the following run-time options, which can also be given as\n"
+"'--<name>' for value one and '--no-<name>' for value zero\n"
+"\n"
+;
+
+static const char *dimacs_usage =
 "\n"
 "where '<dimacs>' is an optionally compressed CNF in DIMACS format by\n"
 "default read from '<stdin>'.  For decompression the solver relies on\n"
@@ -61,6 +69,10 @@ static const char *usage =
 #include <sys/stat.h>
 #include <unistd.h>
 
+#ifndef NPIPELINE
+#include <pthread.h>		// For the parser producer thread.
+#endif
+
 /*------------------------------------------------------------------------*/
 
 // We simply use static global data structures here in 'main.c' which
@@ -79,6 +91,39 @@ static int close_file;		// 0=no-close, 1=fclose, 2=pclose
 static const char *path;	// path name for parse error messages
 static long lineno = 1;		// line number for parse error messages
 static uint64_t bytes;		// read bytes for verbose message
+static size_t parsed_clauses;	// parsed clauses for verbose message
+
+/*------------------------------------------------------------------------*/
+
+#ifndef NPIPELINE
+
+// Unless 'NPIPELINE' is defined parsing is split into two stages running
+// concurrently.  A producer thread reads and tokenizes the DIMACS file and
+// collects the parsed literals (including terminating zeroes) in chunks
+// which are passed through a bounded ring buffer of chunks to the main
+// thread.  The main thread adds them to the solver with the bulk API
+// function 'satch_add_literals'.  Thus reading the file (and waiting for
+// the decompression process) overlaps with adding clauses.
+
+#define CHUNK_SIZE (1u << 16)	// literals per chunk
+#define CHUNKS 4		// size of ring buffer of chunks
+
+struct chunk
+{
+  size_t size;
+  int literals[CHUNK_SIZE];
+};
+
+static struct chunk chunks[CHUNKS];
+static size_t produced, consumed;	// Number of passed chunks.
+static bool finished;		// Producer thread done.
+static bool failed;		// Producer thread found parse error.
+
+static pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t filled = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t emptied = PTHREAD_COND_INITIALIZER;
+
+#endif
 
 /*------------------------------------------------------------------------*/
 
@@ -90,6 +135,7 @@ static int variables;
 /*------------------------------------------------------------------------*/
 
 static bool quiet;		// Turn off default 'verbose' mode.
+static const char *features;	// Path to write features to.
 static int verbose = 1;		// Verbose level (unless 'quiet' is set).
 
 /*------------------------------------------------------------------------*/
@@ -128,16 +174,52 @@ error (const char *fmt, ...)
   exit (1);
 }
 
+// Parse errors are only reported by the main thread.  The producer thread
+// saves the error message, stops and leaves reporting to the main thread.
+
+static char parse_error_message[256];
+
+static void
+report_parse_error (void)
+{
+  fprintf (stderr, "satch: parse error at line %ld in '%s': %s\n",
+	   lineno, path, parse_error_message);
+  exit (1);
+}
+
+#ifndef NPIPELINE
+
+// Signal the main thread that the producer thread is done.  This passes
+// the last (maybe empty) chunk unless a parse error occurred.
+
+static void
+finish_producing (bool error)
+{
+  pthread_mutex_lock (&lock);
+  if (error)
+    failed = true;
+  else
+    produced++;
+  finished = true;
+  pthread_cond_signal (&filled);
+  pthread_mutex_unlock (&lock);
+}
+
+#endif
+
 static void
 parse_error (const char *fmt, ...)
 {
   va_list ap;
-  fprintf (stderr, "satch: parse error at line %ld in '%s': ", lineno, path);
   va_start (ap, fmt);
-  vfprintf (stderr, fmt, ap);
+  vsnprintf (parse_error_message, sizeof parse_error_message, fmt, ap);
   va_end (ap);
-  fputc ('\n', stderr);
-  exit (1);
+#ifdef NPIPELINE
+  report_parse_error ();
+#else
+  finish_producing (true);
+  pthread_exit (0);
+#endif
 }
 
 static void
@@ -180,15 +262,16 @@ banner (void)
 // The following function reads a character from the global file variable,
 // squeezes out carriage return characters (before checking that they are
 // followed by a newline) and maintains read bytes and lines statistics.
+// The file is only read by one thread and thus does not need locking.
 
 static inline int
 next (void)
 {
-  int res = getc (file);
+  int res = getc_unlocked (file);
   if (res == '\r')		// Care for DOS / Windows '\r\n'.
     {
       bytes++;
-      res = getc (file);
+      res = getc_unlocked (file);
       if (res != '\n')
 	parse_error ("expected new line after carriage return");
     }
@@ -199,26 +282,46 @@ next (void)
   return res;
 }
 
-// This is the actual DIMACS file parser.  It uses the 'next' function to
-// read bytes from the global file.  Beside proper error messages in case of
-// parse errors it also prints information about parsed clauses etc.
+#ifndef NPIPELINE
 
-// The file is not opened here, since we want to print the 'banner' in
-// 'main' after checking that we can really access and open the file.  But
-// it is closed in this function to print the information just discussed at
-// the right place where this should happen.
+// Pass the current (full or last) chunk to the main thread and wait until
+// the next chunk in the ring buffer has been added to the solver.
 
 static void
-parse (void)
+produce_chunk (void)
 {
-  satch_start_profiling_parsing (solver);
+  pthread_mutex_lock (&lock);
+  produced++;
+  pthread_cond_signal (&filled);
+  while (produced - consumed == CHUNKS)
+    pthread_cond_wait (&emptied, &lock);
+  pthread_mutex_unlock (&lock);
+  chunks[produced % CHUNKS].size = 0;
+}
 
-  if (!quiet)
-    {
-      satch_section (solver, "parsing");
-      message ("parsing '%s'", path);
-    }
+#endif
+
+static inline void
+add_literal (int lit)
+{
+#ifdef NPIPELINE
+  satch_add (solver, lit);
+#else
+  struct chunk *chunk = chunks + produced % CHUNKS;
+  chunk->literals[chunk->size++] = lit;
+  if (chunk->size == CHUNK_SIZE)
+    produce_chunk ();
+#endif
+}
+
+// This is the actual DIMACS file parser.  It uses the 'next' function to
+// read bytes from the global file and 'add_literal' to pass on literals.
+// Beside proper error messages in case of parse errors it also prints
+// information about the header.
 
+static void
+read_dimacs (void)
+{
   int ch;
   while ((ch = next ()) == 'c')
     {
@@ -291,7 +394,6 @@ parse (void)
   satch_reserve (solver, variables);
 #endif
 
-  size_t parsed_clauses = 0;
   int lit = 0;
 
   for (;;)
@@ -359,7 +461,7 @@ parse (void)
       // including the zeroes terminating each clause.  Thus we do not have
       // to use another function for adding a clause explicitly.
       //
-      satch_add (solver, lit);
+      add_literal (lit);
 
       // The following 'goto' is necessary to avoid reading another
       // character which would result in a spurious parse error for a comment
@@ -380,6 +482,71 @@ parse (void)
 	parse_error ("%zu clauses missing",
 		     specified_clauses - parsed_clauses);
     }
+}
+
+#ifndef NPIPELINE
+
+static void *
+producer (void *dummy)
+{
+  (void) dummy;
+  read_dimacs ();
+  finish_producing (false);
+  return 0;
+}
+
+// The main thread adds the chunks passed by the 'producer' to the solver.
+
+static void
+consumer (void)
+{
+  for (;;)
+    {
+      pthread_mutex_lock (&lock);
+      while (consumed == produced && !finished)
+	pthread_cond_wait (&filled, &lock);
+      const bool done = failed || consumed == produced;
+      pthread_mutex_unlock (&lock);
+      if (done)
+	break;
+      const struct chunk *const chunk = chunks + consumed % CHUNKS;
+      satch_add_literals (solver, chunk->size, chunk->literals);
+      pthread_mutex_lock (&lock);
+      consumed++;
+      pthread_cond_signal (&emptied);
+      pthread_mutex_unlock (&lock);
+    }
+}
+
+#endif
+
+// The file is not opened here, since we want to print the 'banner' in
+// 'main' after checking that we can really access and open the file.  But
+// it is closed in this function to print the information about parsed
+// clauses at the right place where this should happen.
+
+static void
+parse (void)
+{
+  satch_start_profiling_parsing (solver);
+
+  if (!quiet)
+    {
+      satch_section (solver, "parsing");
+      message ("parsing '%s'", path);
+    }
+
+#ifdef NPIPELINE
+  read_dimacs ();
+#else
+  pthread_t thread;
+  if (pthread_create (&thread, 0, producer, 0))
+    error ("failed to start parser thread");
+  consumer ();
+  pthread_join (thread, 0);
+  if (failed)
+    report_parse_error ();
+#endif
 
   const double seconds = satch_stop_profiling_parsing (solver);
   if (parsed_clauses == 1)
@@ -431,6 +598,34 @@ print_value (int lit)
   size_buffer += size_tmp;
 }
 
+// Variables can be sparse and thus we only print the values of imported
+// variables (which occurred in clauses) sorted by their index, instead of
+// going over all variables up to the maximum variable in the header.
+
+static int
+cmp_variables (const void *p, const void *q)
+{
+  const int a = *(const int *) p, b = *(const int *) q;
+  return (a > b) - (a < b);
+}
+
+static void
+print_witness (void)
+{
+  const int imported = satch_imported_variables (solver);
+  int *sorted = malloc ((imported + 1) * sizeof *sorted);
+  if (!sorted)
+    error ("out-of-memory allocating witness variables");
+  for (int i = 0; i < imported; i++)
+    sorted[i] = satch_imported_variable (solver, i);
+  qsort (sorted, imported, sizeof *sorted, cmp_variables);
+  for (int i = 0; i < imported; i++)
+    print_value (satch_val (solver, sorted[i]));
+  print_value (0);
+  flush_printed_values ();
+  free (sorted);
+}
+
 /*------------------------------------------------------------------------*/
 
 // For compressed files just opening a pipe will not return a zero file
@@ -549,6 +744,56 @@ init_signal_handler (void)
 
 /*------------------------------------------------------------------------*/
 
+// Run-time options are set directly after parsing their value.  Command
+// line option names use dashes instead of the underscores in the library.
+
+#define MAX_OPTION_NAME 64
+
+static void
+print_usage (void)
+{
+  fputs (usage, stdout);
+  satch_usage_options ();
+  fputs (dimacs_usage, stdout);
+}
+
+static bool
+parse_option (const char *arg)
+{
+  int value = 1;
+  const char *end = strchr (arg, '=');
+  if (end)
+    {
+      const char *p = end + 1;
+      if (*p == '-')
+	p++;
+      if (!isdigit (*p))
+	return false;
+      long tmp = 0;
+      while (isdigit (*p))
+	if ((tmp = 10 * tmp + (*p++ - '0')) > INT_MAX)
+	  return false;
+      if (*p)
+	return false;
+      value = (end[1] == '-') ? -tmp : tmp;
+    }
+  else
+    {
+      end = arg + strlen (arg);
+      if (!strncmp (arg, "no-", 3))
+	arg += 3, value = 0;
+    }
+  if (end == arg || end - arg >= MAX_OPTION_NAME)
+    return false;
+  char name[MAX_OPTION_NAME], *q = name;
+  for (const char *p = arg; p != end; p++)
+    *q++ = (*p == '-') ? '_' : *p;
+  *q = 0;
+  return satch_set_option (solver, name, value);
+}
+
+/*------------------------------------------------------------------------*/
+
 int
 main (int argc, char **argv)
 {
@@ -556,11 +801,14 @@ main (int argc, char **argv)
 #ifndef NDEBUG
   bool logging = false;
 #endif
+  solver = satch_init ();
+  if (!solver)
+    error ("failed to initialize solver");
   for (int i = 1; i < argc; i++)
     {
       const char *arg = argv[i];
       if (!strcmp (arg, "-h"))
-	fputs (usage, stdout), exit (0);
+	print_usage (), exit (0);
       if (!strcmp (arg, "--version"))
 	printf ("%s\n", satch_version ()), exit (0);
       else if (!strcmp (arg, "-n") || !strcmp (arg, "--no-witness"))
@@ -575,6 +823,10 @@ main (int argc, char **argv)
 #else
 	logging = true;
 #endif
+      else if (!strncmp (arg, "--features=", 11) && arg[11])
+	features = arg + 11;
+      else if (arg[0] == '-' && arg[1] == '-' && parse_option (arg + 2))
+	;
       else if (arg[0] == '-')
 	error ("invalid command option '%s' (try '-h')", arg);
       else if (path)
@@ -588,9 +840,6 @@ main (int argc, char **argv)
 #endif
   if (quiet && verbose > 1)
     error ("can not combine '--quiet' and '--verbose'");
-  solver = satch_init ();
-  if (!solver)
-    error ("failed to initialize solver");
   if (!quiet)
     satch_set_verbose_level (solver, verbose);
 #ifndef NDEBUG
@@ -614,6 +863,8 @@ main (int argc, char **argv)
   init_signal_handler ();
   banner ();
   parse ();
+  if (features && !satch_write_features (solver, features))
+    error ("can not write features to '%s'", features);
   int res = satch_solve (solver);
   if (!quiet)
     satch_section (solver, "result");
@@ -621,12 +872,7 @@ main (int argc, char **argv)
     {
       printf ("s SATISFIABLE\n");
       if (witness)
-	{
-	  for (int i = 1; i <= variables; i++)
-	    print_value (satch_val (solver, i));
-	  print_value (0);
-	  flush_printed_values ();
-	}
+	print_witness ();
       fflush (stdout);
     }
   else if (res == UNSATISFIABLE)
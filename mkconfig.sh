@@ -17,6 +17,15 @@ satch_version (void)
 #ifdef NBLOCK
   "-block"
 #endif
+#ifdef NBLOCKED
+  "-blocked"
+#endif
+#ifdef NBUMPREASONS
+  "-bumpreasons"
+#endif
+#ifdef NCOMPACT
+  "-compact"
+#endif
 #ifdef NLEARN
   "-learn"
 #endif
@@ -26,6 +35,9 @@ satch_version (void)
 #ifdef NMODE
   "-mode"
 #endif
+#ifdef NPIPELINE
+  "-pipeline"
+#endif
 #ifdef NREDUCE
   "-reduce"
 #endif
@@ -34,6 +46,21 @@ satch_version (void)
 #endif
 #ifdef NSORT
   "-sort"
+#endif
+#ifdef NSTRENGTHEN
+  "-strengthen"
+#endif
+#ifdef NSUBSUME
+  "-subsume"
+#endif
+#ifdef NTRANSITIVE
+  "-transitive"
+#endif
+#ifdef PACKED
+  "+packed"
+#endif
+#ifdef COMPRESS
+  "+compress"
 #endif
   ;
 }
@@ -38,8 +38,10 @@
 
 /*------------------------------------------------------------------------*/
 
-// System specific include files for 'getrusage', 'stat', and 'access'.
+// System specific include files for 'getrusage', 'stat', 'access' and
+// 'mmap'.
 
+#include <sys/mman.h>
 #include <sys/resource.h>
 #include <sys/time.h>
 #include <sys/types.h>
@@ -56,12 +58,21 @@
 //   NDEBUG    disable proof, witness and assertion checking
 //
 //   NBLOCK    disable blocking literals thus slows down propagation
+//   NBLOCKED  disable blocked and covered clause elimination
+//   NBUMPREASONS disable bumping reason side literals
+//   NCOMPACT  disable compacting and renumbering variables
 //   NLEARN    disable keeping learned clauses (DPLL with backjumping)
 //   NMINIMIZE disable clause minimization during learning
 //   NMODE     disable switching between stable and focused mode
 //   NREDUCE   disable clause reduction completely (keep all clauses)
 //   NRESTART  disable restarts completely (moving average based)
 //   NSORT     disable heuristic which keeps bumped variables in order
+//   NSTRENGTHEN disable on-the-fly strengthening of reason clauses
+//   NSUBSUME  disable eager subsumption of recently learned clauses
+//   NTRANSITIVE disable transitive reduction of binary clauses
+//
+//   PACKED    enable two bit per variable assignment (see 'literal_value')
+//   COMPRESS  enable compressed long learned clauses (see 'encode_tail')
 //   
 // While 'NDEBUG' is used frequently through-out the code the other macros
 // are only used to disable specific default features in order to run and
@@ -90,6 +101,32 @@
 #define NMINIMIZE
 #endif
 
+// NLEARN implies NSUBSUME
+#if defined(NLEARN) && !defined(NSUBSUME)
+#define NSUBSUME
+#endif
+
+// Disabling all simplification passes disables the scheduler ('NSIMPLIFY'
+// is only derived here and thus not a configuration option).
+
+#if defined(NBLOCKED) && defined(NTRANSITIVE) && defined(NCOMPACT) && \
+   !defined(NSIMPLIFY)
+#define NSIMPLIFY
+#endif
+
+// Compressed clauses need the clause arena (NREDUCE disables COMPRESS).
+
+#if defined(NREDUCE) && defined(COMPRESS)
+#undef COMPRESS
+#endif
+
+// Spilling cold clauses to a file needs reductions and compaction, which
+// reloads them ('NSPILL' is only derived and not a configuration option).
+
+#if (defined(NREDUCE) || defined(NCOMPACT)) && !defined(NSPILL)
+#define NSPILL
+#endif
+
 /*------------------------------------------------------------------------*/
 
 // Hard coded options for simplicity.
@@ -100,23 +137,134 @@
 #define fast_alpha		3e-2	// exponential moving average decay
 #define restart_interval	1	// basic (focused) restart interval
 #define restart_margin		1.25	// margin for fast_glue > slow_glue
+#define restart_block_conflicts	1e4	// no blocking before these conflicts
+#define restart_block_margin	1.4	// margin for trail > average trail
+#define restart_block_delay	50	// postponed restart conflicts
 #ifndef NMODE
 #define mode_interval		1e3	// mode switching conflict interval
 #define inner_interval		1024	// stable mode restart interval
 #define inner_outer_factor	2	// inner / outer increase factor
+#define mode_progress_alpha	0.5	// progress moving average decay
+#define mode_min_factor		0.25	// minimum stable / focused ticks
+#define mode_max_factor		4	// maximum stable / focused ticks
+#define bandit_exploration	2	// UCB1 exploration factor
 #endif
 #endif
 
 #ifndef NREDUCE
 #define reduce_fraction         0.75	// reduced number of clauses
 #define reduce_glue_limit	2	// kept glue limit
+#define reduce_used_glue	6	// used clauses kept for two reductions
 #define reduce_interval  	300	// base reduce conflicts interval
+#define arena_block_size	(1<<20)	// minimum clause arena block bytes
+#endif
+
+#ifdef COMPRESS
+#ifndef compress_size		// Smaller values used in 'tatch.sh'.
+#define compress_size		50	// minimum size of compressed clauses
+#endif
+#ifndef compress_plain
+#define compress_plain		4	// uncompressed first literals (> 1)
+#endif
 #endif
 
 #ifndef NMINIMIZE
 #define minimize_depth		1e4	// recursive minimization depth
 #endif
 
+#ifndef NSUBSUME
+#define subsume_recent		20	// eagerly checked learned clauses
+#endif
+
+#ifndef NBUMPREASONS
+#define bump_reasons_limit	10	// maximum reason side literals
+#define bump_reasons_max_delay	100	// maximum delay after failure
+#endif
+
+#ifndef NBLOCKED
+#define blocked_interval	2e3	// blocked clause elimination interval
+#define blocked_effort		0.1	// relative to search ticks
+#define blocked_min_effort	1e5	// minimum blocked clause ticks
+#define blocked_occurrences	1e3	// maximum resolution candidates
+#endif
+
+#ifndef NTRANSITIVE
+#define transitive_interval	3e3	// transitive reduction interval
+#define transitive_effort	0.05	// relative to search ticks
+#define transitive_min_effort	1e5	// minimum transitive reduction ticks
+#endif
+
+#ifndef NCOMPACT
+#define compact_interval	2e3	// variable compaction interval
+#define compact_effort		0	// not limited (linear in formula size)
+#define compact_min_effort	0	// not limited (linear in formula size)
+#endif
+
+/*------------------------------------------------------------------------*/
+
+// Options which can be changed at run-time through 'satch_set_option' (and
+// on the command line of the stand-alone solver) are listed here with the
+// same idiom as 'PROFILES' below, giving name, default value, minimum and
+// maximum value and a description.  They have to be disabled if the code
+// using them is disabled at compile time.
+
+#define OPTIONS \
+OPTION (auto_config, 0, 0, 1, \
+  "select options by instance features") \
+OPTION (reserve_memory, 0, 0, 1, \
+  "reserve address space of variable arrays up-front") \
+OPTION (huge_pages, 0, 0, 1, \
+  "align large arrays and arena to transparent huge pages") \
+OPTION (deduplicate, 0, 0, 1, \
+  "remove duplicated clauses during import") \
+OPTION (deduplicate_memory, 64, 1, 4096, \
+  "maximum size of import clause hash table in MB") \
+OPTION_IF_RESTART (restart_blocking, 1, 0, 1, \
+  "postpone restarts on large trail") \
+OPTION_IF_MODE (stable_restarts, 0, 0, 1, \
+  "stable restarts (0=inner-outer, 1=Luby)") \
+OPTION_IF_MODE (adaptive_mode, 1, 0, 1, \
+  "adapt stable mode ticks to progress") \
+OPTION_IF_MODE (target_phases, 0, 0, 1, \
+  "use target phases in stable mode") \
+OPTION_IF_MODE (bandit, 0, 0, 1, \
+  "select stable mode heuristics by bandit") \
+OPTION_IF_BUMPREASONS (bump_reasons, 1, 0, 1, \
+  "bump reason side literals") \
+OPTION_IF_REDUCE (reorder_clauses, 1, 0, 1, \
+  "move clauses in watch order during reduction") \
+OPTION_IF_SPILL (spill_clauses, 0, 0, 1, \
+  "spill cold learned clauses to a temporary file") \
+OPTION_IF_REDUCE (sort_watches, 1, 0, 1, \
+  "sort watches by clause size during reduction")
+
+#define DO_NOT_OPTION(NAME,DEFAULT,MIN,MAX,DESCRIPTION) /**/
+#ifdef NRESTART
+#define OPTION_IF_RESTART DO_NOT_OPTION
+#else
+#define OPTION_IF_RESTART OPTION
+#endif
+#ifdef NMODE
+#define OPTION_IF_MODE DO_NOT_OPTION
+#else
+#define OPTION_IF_MODE OPTION
+#endif
+#ifdef NBUMPREASONS
+#define OPTION_IF_BUMPREASONS DO_NOT_OPTION
+#else
+#define OPTION_IF_BUMPREASONS OPTION
+#endif
+#ifdef NREDUCE
+#define OPTION_IF_REDUCE DO_NOT_OPTION
+#else
+#define OPTION_IF_REDUCE OPTION
+#endif
+#ifdef NSPILL
+#define OPTION_IF_SPILL DO_NOT_OPTION
+#else
+#define OPTION_IF_SPILL OPTION
+#endif
+
 /*------------------------------------------------------------------------*/
 
 // Local include files.
@@ -212,14 +360,103 @@ NOT (unsigned lit)
 
 /*------------------------------------------------------------------------*/
 
+// The current assignment is by default stored in the literal indexed
+// 'values' array with one signed byte per literal, where '1' means true,
+// '-1' false and '0' unassigned.  The value of both a literal and its
+// negation are stored, which turns every value look-up into a simple
+// array access.  If 'PACKED' is defined (configured with '--packed') only
+// two bits per variable are used instead, i.e., four variables share one
+// byte, which reduces the memory needed for 'values' by a factor of eight.
+// These two bits hold the value of the positive literal as two-complement
+// number ('1' for true, '3' for '-1' false, '0' for unassigned) and are
+// decoded without branches by sign-extension and conditional negation.
+
+#ifdef PACKED
+
+static inline size_t
+bytes_values (size_t variables)
+{
+  return (variables + 3) / 4;
+}
+
+static inline signed char
+literal_value (const signed char *values, unsigned lit)
+{
+  const unsigned idx = INDEX (lit);
+  const unsigned shift = 2 * (idx & 3);
+  const unsigned bits = ((unsigned char) values[idx >> 2] >> shift) & 3;
+  const int value = (int) (bits << 30) >> 30;
+  const int negate = -(int) SIGN (lit);
+  return (value ^ negate) - negate;
+}
+
+static inline void
+set_value (signed char *values, unsigned lit)
+{
+  const unsigned idx = INDEX (lit);
+  const unsigned shift = 2 * (idx & 3);
+  const unsigned bits = 1 | (SIGN (lit) << 1);
+  values[idx >> 2] |= bits << shift;
+}
+
+static inline void
+reset_value (signed char *values, unsigned lit)
+{
+  const unsigned idx = INDEX (lit);
+  const unsigned shift = 2 * (idx & 3);
+  values[idx >> 2] &= ~(3u << shift);
+}
+
+#else
+
+static inline size_t
+bytes_values (size_t variables)
+{
+  return 2 * variables;
+}
+
+static inline signed char
+literal_value (const signed char *values, unsigned lit)
+{
+  return values[lit];
+}
+
+static inline void
+set_value (signed char *values, unsigned lit)
+{
+  values[lit] = 1;
+  values[NOT (lit)] = -1;
+}
+
+static inline void
+reset_value (signed char *values, unsigned lit)
+{
+  values[lit] = 0;
+  values[NOT (lit)] = 0;
+}
+
+#endif
+
+/*------------------------------------------------------------------------*/
+
+// The clause header uses bit-fields for flags and glue, which together with
+// the size only take 8 bytes.  The 64-bit 'id' is only needed for logging
+// and thus only kept if checking is enabled ('NDEBUG' undefined).
+
+#define MAX_GLUE ((1u<<25)-1)	// Larger glue values are clipped.
+
 struct clause
 {
+#ifndef NDEBUG
   uint64_t id;			// from 'solver->statistics.added'
-  bool garbage;			// collect clause at next garbage collection
-  bool protected;		// do not collect reason clauses
-  bool redundant;		// redundant / learned (not irredundant)
-  bool used;			// used since last clause reduction
-  unsigned glue;		// glucose level (LBD)
+#endif
+  bool garbage:1;		// collect clause at next garbage collection
+  bool protected:1;		// do not collect reason clauses
+  bool redundant:1;		// redundant / learned (not irredundant)
+  bool spilled:1;		// garbage but written to spill file
+  bool compressed:1;		// literals after 'compress_plain' encoded
+  unsigned used:2;		// used recently (two-bit counter 0..2)
+  unsigned glue:25;		// glucose level (LBD)
   unsigned size;		// size of variadic literals array
   unsigned literals[];		// the actual literals (of length 'size') 
 };
@@ -250,6 +487,32 @@ struct watches			// Stack of watches.
   struct watch *begin, *end, *allocated;
 };
 
+#ifndef NREDUCE
+
+struct blocks			// Stack of allocated arena blocks.
+{
+  char **begin, **end, **allocated;
+};
+
+struct arena			// Clause memory allocated in blocks.
+{
+  char *top;			// Next free byte in last block.
+  char *limit;			// End of last block.
+  struct blocks blocks;		// All allocated blocks.
+};
+
+#endif
+
+#ifndef NSPILL
+
+struct spill			// Cold clauses written to a file.
+{
+  FILE *file;			// Temporary file (opened lazily).
+  size_t bytes;			// Bytes written to the file.
+};
+
+#endif
+
 struct limits
 {
 #ifndef NRESTART
@@ -263,7 +526,16 @@ struct limits
     {
       uint64_t inner;		// Inner restart conflict interval.
       uint64_t outer;		// Outer restart conflict interval.
+      uint64_t luby;		// Stable restarts for Luby sequence.
     } restarts;
+    struct
+    {
+      uint64_t ticks;		// Search ticks at start of mode.
+      uint64_t conflicts;	// Conflicts at start of mode.
+      uint64_t glue;		// Sum of glue of learned clauses in mode.
+      unsigned fixed;		// Fixed variables at start of mode.
+      unsigned trail;		// Maximum trail size at conflicts in mode.
+    } progress;
   } mode;
 #endif
 #endif
@@ -274,6 +546,37 @@ struct limits
     unsigned fixed;		// Root level fixed at reduction.
   } reduce;
 #endif
+#ifndef NBUMPREASONS
+  struct
+  {
+    unsigned delay;		// Remaining conflicts to skip.
+    unsigned interval;		// Delay after the next attempt.
+  } bump_reasons;
+#endif
+#ifndef NBLOCKED
+  struct
+  {
+    uint64_t conflicts;		// Conflict limit on eliminating.
+    uint64_t ticks;		// Search ticks at last elimination.
+    size_t position;		// Resume position in irredundant clauses.
+  } blocked;
+#endif
+#ifndef NTRANSITIVE
+  struct
+  {
+    uint64_t conflicts;		// Conflict limit on transitive reduction.
+    uint64_t ticks;		// Search ticks at last transitive reduction.
+    unsigned literal;		// Resume literal.
+  } transitive;
+#endif
+#ifndef NCOMPACT
+  struct
+  {
+    uint64_t conflicts;		// Conflict limit on compacting.
+    uint64_t ticks;		// Search ticks at last compaction.
+    unsigned fixed;		// Root level fixed at last compaction.
+  } compact;
+#endif
 };
 
 struct options			// Runtime options.
@@ -282,6 +585,10 @@ struct options			// Runtime options.
   bool logging;
 #endif
   unsigned verbose;
+#define OPTION(NAME,DEFAULT,MIN,MAX,DESCRIPTION) \
+  int NAME;			// see 'OPTIONS'
+  OPTIONS
+#undef OPTION
 };
 
 struct statistics		// Runtime statistics.
@@ -289,27 +596,69 @@ struct statistics		// Runtime statistics.
   uint64_t conflicts;		// Total number of conflicts.
   uint64_t decisions;		// Total number of decisions.
   uint64_t propagations;	// Propagated literals.
+#ifndef NBLOCKED
+  uint64_t eliminations;	// Number of blocked clause eliminations.
+#endif
 #ifndef NREDUCE
   uint64_t reductions;		// Number of reductions.
 #endif
+#ifdef COMPRESS
+  uint64_t compressed;		// Compressed learned clauses.
+  uint64_t compressed_bytes;	// Bytes of compressed clauses.
+  uint64_t uncompressed_bytes;	// Bytes these would need otherwise.
+#endif
+#ifndef NSPILL
+  uint64_t spilled;		// Spilled cold clauses.
+  uint64_t reloaded;		// Reloaded spilled clauses.
+#endif
 #ifndef NRESTART
   uint64_t restarts;		// Number of restarts.
+  uint64_t postponed;		// Number of blocked restarts.
 #ifndef NMODE
   uint64_t switched;		// Number of mode switches.
 #endif
 #endif
   uint64_t ticks;		// Propagation ticks.
+#ifndef NTRANSITIVE
+  uint64_t transitive_reductions;	// Number of transitive reductions.
+  uint64_t transitive_reduced;	// Removed transitive binary clauses.
+  uint64_t transitive_units;	// Units found in transitive reduction.
+  uint64_t duplicated;		// Removed duplicated binary clauses.
+#endif
+#ifndef NCOMPACT
+  uint64_t compactions;		// Number of variable compactions.
+  uint64_t compacted;		// Removed root-level fixed variables.
+#endif
 
   uint64_t added;		// Number of added clauses.
+  uint64_t deduplicated;	// Duplicated imported clauses.
   uint64_t deleted;		// Number of deleted clauses.
   uint64_t irredundant;		// Current number of irredundant clauses.
   uint64_t redundant;		// Current number of redundant clauses.
 
+#ifndef NBLOCKED
+  uint64_t blocked;		// Eliminated blocked clauses.
+  uint64_t covered;		// Eliminated covered clauses.
+#endif
+
   uint64_t deduced;		// Deduced literals.
   uint64_t learned;		// Learned literals.
+  uint64_t bumped;		// Bumped variables.
+#ifndef NBUMPREASONS
+  uint64_t reasons;		// Bumped reason side variables.
+#endif
 #ifndef NMINIMIZE
   uint64_t minimized;		// Minimized literals.
 #endif
+#ifndef NREDUCE
+  uint64_t promoted;		// Glue of reason clause improved.
+#endif
+#ifndef NSUBSUME
+  uint64_t subsumed;		// Eagerly subsumed learned clauses.
+#endif
+#ifndef NSTRENGTHEN
+  uint64_t strengthened;	// On-the-fly strengthened reasons.
+#endif
 
   uint64_t sections;		// Number of calls to 'section'.
   uint64_t reported;		// Number of calls to 'report'.
@@ -327,6 +676,42 @@ struct queue			// variable move to front decision queue
   unsigned stamp;		// enqueue time stamp
 };
 
+#ifndef NMODE
+
+// The arms of the bandit are all combinations of the values of binary
+// run-time options listed here (see 'pull_arm').
+
+#define BANDIT_OPTIONS \
+BANDIT_OPTION (stable_restarts) \
+BANDIT_OPTION (target_phases) \
+BANDIT_OPTION_IF_BUMPREASONS (bump_reasons)
+
+#define DO_NOT_BANDIT_OPTION(NAME) /**/
+#ifdef NBUMPREASONS
+#define BANDIT_OPTION_IF_BUMPREASONS DO_NOT_BANDIT_OPTION
+#else
+#define BANDIT_OPTION_IF_BUMPREASONS BANDIT_OPTION
+#endif
+
+#define MAX_ARMS	8	// Two to the number of bandit options.
+
+struct bandit			// Multi-armed bandit over stable mode arms.
+{
+  unsigned arm;			// Arm of current stable mode phase.
+  uint64_t pulls;		// Total number of pulled arms.
+  uint64_t count[MAX_ARMS];	// Number of times an arm was pulled.
+  double reward[MAX_ARMS];	// Sum of rewards of an arm.
+  struct
+  {
+#define BANDIT_OPTION(NAME) \
+    int NAME;
+    BANDIT_OPTIONS
+#undef BANDIT_OPTION
+  } saved;			// Options before pulling arm.
+};
+
+#endif
+
 struct analyzed			// Analyzed / seen variables.
 {
   unsigned idx;
@@ -340,6 +725,31 @@ struct analyzed_stack		// Stack of analyzed indices with stamps.
   struct analyzed *begin, *end, *allocated;
 };
 
+struct import			// Imported external variable.
+{
+  int external;			// External variable index.
+  unsigned internal;		// Internal literal it is mapped to.
+};
+
+struct imports			// Stack of imported variables.
+{
+  struct import *begin, *end, *allocated;
+};
+
+struct fingerprint		// Hashed imported clause.
+{
+  uint64_t hash;		// Order independent hash of literals.
+  struct clause *clause;	// Imported clause ('0' if slot empty).
+};
+
+struct fingerprints		// Hash table of imported clauses.
+{
+  struct fingerprint *table;	// Open addressing with linear probing.
+  size_t size;			// Size of table (power of two).
+  size_t count;			// Number of hashed clauses.
+  bool full;			// Memory limit reached.
+};
+
 struct trail			// Pre-allocated stack of literals.
 {
   unsigned *begin, *end;	// As in 'stack' (can use stack macros).
@@ -349,12 +759,18 @@ struct trail			// Pre-allocated stack of literals.
 struct averages			// Exponential moving averages.
 {
   double conflict_level;	// Slow moving average of conflict level.
+#ifndef NRESTART
+  double trail;			// Slow moving average of trail size.
+#endif
   double slow_glue;		// Slow moving average of glue.
   double slow_exp;		// Cached 'slow_beta^n'.
 #ifndef NRESTART
   double fast_glue;		// Fast moving average of glue.
   double fast_exp;		// Cached 'fast_beta^n'.
 #endif
+#ifndef NMODE
+  double progress[2];		// Progress per tick (focused, stable).
+#endif
 };
 
 // We use this idiom of defining at compile time a list of code parameters
@@ -368,10 +784,13 @@ struct averages			// Exponential moving averages.
 // '#NAME'), or even generate new symbols (see 'SIGNALS' in 'main.c').
 
 #define PROFILES \
+PROFILE (blocked) 		/* time spent in blocked clause elimination */ \
+PROFILE (compact) 		/* time spent in compacting variables */ \
 PROFILE (focused) 		/* time spent in focused mode */ \
 PROFILE (parse) 		/* time spent parsing */ \
 PROFILE (solve) 		/* time spent solving */ \
 PROFILE (stable) 		/* time spent in stable mode */ \
+PROFILE (transitive) 		/* time spent in transitive reduction */ \
 PROFILE (total)			/* total time spent */
 
 struct profile
@@ -403,11 +822,23 @@ struct satch
   unsigned level;		// current decision level
   unsigned size;		// number of variables
   size_t capacity;		// allocated variables
+  bool reserved;		// variable arrays reserved with 'mmap'
+  int *exported;		// import positions plus one of variables
+  struct imports imports;	// imported external variables in order
+  unsigned *table;		// hash table of positions in 'imports'
+  size_t hashed;		// size of hash table (power of two)
+  struct fingerprints fingerprints;	// hashed imported clauses
+  int maximum;			// maximum imported external variable
   unsigned unassigned;		// number of unassigned variables
   unsigned *levels;		// decision levels of variables
   struct link *links;		// variable links in decision queue
   signed char *values;		// current assignment of literals
   unsigned char *saved;		// saved assignment of a variable
+#ifndef NMODE
+  signed char *targets;		// target assignment (stable mode)
+  unsigned target;		// size of target assignment
+  struct bandit bandit;		// stable mode heuristics selection
+#endif
   signed char *marks;		// mark flag of variable
 #ifndef NMINIMIZE
   struct unsigned_stack marked;	// marked variables
@@ -419,10 +850,27 @@ struct satch
   struct trail trail;		// assigned literals
   struct analyzed_stack seen;	// analyzed literals
   struct unsigned_stack clause;	// temporary clause
+#ifdef COMPRESS
+  struct unsigned_stack decoded;	// temporary decoded clause
+#endif
   struct unsigned_stack blocks;	// analyzed decision levels
   struct clauses irredundant;	// current irredundant clauses
 #ifndef NLEARN
   struct clauses redundant;	// current redundant clauses
+#endif
+#ifndef NREDUCE
+  struct arena arena;		// memory of all clauses
+#endif
+#ifndef NSPILL
+  struct spill spill;		// spilled cold clauses
+#endif
+#ifndef NSUBSUME
+  struct clause *recent[subsume_recent];	// recently learned clauses
+  unsigned next_recent;		// next position in 'recent' ring
+#endif
+#ifndef NBLOCKED
+  struct clauses *occurrences;	// occurrence lists (during elimination)
+  struct unsigned_stack extension;	// witness reconstruction stack
 #endif
   struct limits limits;		// limits on restart
   struct options options;	// a few runtime options
@@ -430,7 +878,7 @@ struct satch
   struct statistics statistics;	// statistic counters
   struct profiles profiles;	// built in run-time profiling
 #ifndef NDEBUG
-  struct int_stack added;	// added external clause
+  struct int_stack added;	// added clause (exported)
   struct int_stack original;	// copy of all original clauses
   struct checker *checker;	// internal proof checker
 #endif
@@ -489,11 +937,60 @@ do { \
 #define all_literals(LIT) \
   unsigned LIT = 0, END_LITERALS = LITERALS; LIT < END_LITERALS; LIT++
 
+#ifndef COMPRESS
+
 #define all_literals_in_clause(LIT,C) \
   unsigned LIT, * P_ ## LIT = (C)->literals, \
                 * const END_ ## LIT = P_ ## LIT + (C)->size; \
   (P_ ## LIT != END_ ## LIT) && (LIT = *P_ ## LIT, true); ++P_ ## LIT
 
+#else
+
+// With 'COMPRESS' defined learned clauses with at least 'compress_size'
+// literals are compressed.  Their first 'compress_plain' literals, which
+// include the two watched literals, are kept as is.  They are followed by
+// the number of bytes reserved for the remaining 'tail' literals, which
+// are sorted and then stored as differences to their predecessor (the
+// first one to zero) in a variable-length byte encoding with seven bits
+// per byte, where the most significant bit means that more bytes follow.
+// Iterating over the literals of a clause decodes them on-the-fly.
+
+static inline unsigned *
+reserved_tail (const struct clause *c)
+{
+  assert (c->compressed);
+  return (unsigned *) c->literals + compress_plain;
+}
+
+static inline unsigned char *
+encoded_tail (const struct clause *c)
+{
+  return (unsigned char *) (reserved_tail (c) + 1);
+}
+
+static inline unsigned
+next_literal (const struct clause *c, unsigned i, unsigned *offset,
+	      unsigned prev)
+{
+  if (i < compress_plain || !c->compressed)
+    return c->literals[i];
+  const unsigned char *p = encoded_tail (c) + *offset, *const begin = p;
+  unsigned delta = 0, shift = 0, byte;
+  do
+    byte = *p++, delta |= (byte & 127) << shift, shift += 7;
+  while (byte & 128);
+  *offset += p - begin;
+  return (i == compress_plain ? 0 : prev) + delta;
+}
+
+#define all_literals_in_clause(LIT,C) \
+  unsigned LIT, I_ ## LIT = 0, O_ ## LIT = 0, L_ ## LIT = 0; \
+  (I_ ## LIT < (C)->size) && \
+  (LIT = L_ ## LIT = next_literal ((C), I_ ## LIT, &O_ ## LIT, L_ ## LIT), \
+   true); ++I_ ## LIT
+
+#endif
+
 #define all_irredundant_clauses(C) \
   all_pointers_on_stack (struct clause, C, solver->irredundant)
 
@@ -759,6 +1256,63 @@ current_resident_set_size (void)
 
 /*------------------------------------------------------------------------*/
 
+// With the 'huge_pages' option large variable and literal indexed arrays
+// as well as the blocks of the clause arena are aligned to (and padded to
+// multiples of) the two megabyte huge page size of x86-64 Linux and we
+// advise the kernel with 'madvise' to back them with transparent huge
+// pages.  This reduces TLB misses during propagation on large instances,
+// which mostly access 'values', 'watches', 'links' and the clauses.  Small
+// arrays are still allocated with 'calloc' to avoid wasting memory.
+
+#define huge_page_size ((size_t) 1 << 21)
+
+static size_t
+huge_page_aligned (size_t bytes)
+{
+  return (bytes + huge_page_size - 1) & ~(huge_page_size - 1);
+}
+
+static void
+advise_huge_pages (void *start, size_t bytes)
+{
+#ifdef MADV_HUGEPAGE
+  (void) madvise (start, bytes, MADV_HUGEPAGE);	// Only a hint.
+#else
+  (void) start, (void) bytes;
+#endif
+}
+
+static void *
+allocate_huge_pages (size_t bytes)
+{
+  bytes = huge_page_aligned (bytes);
+  void *res;
+  if (posix_memalign (&res, huge_page_size, bytes))
+    out_of_memory (bytes);
+  advise_huge_pages (res, bytes);
+  return res;
+}
+
+// Number of transparent huge pages currently backing anonymous memory of
+// this process, which is again very Linux specific.
+
+static uint64_t
+huge_pages_in_use (void)
+{
+  FILE *file = fopen ("/proc/self/smaps_rollup", "r");
+  if (!file)
+    return 0;
+  uint64_t kilobytes = 0;
+  char line[128];
+  while (fgets (line, sizeof line, file))
+    if (sscanf (line, "AnonHugePages: %" SCNu64, &kilobytes) == 1)
+      break;
+  fclose (file);
+  return (kilobytes << 10) / huge_page_size;
+}
+
+/*------------------------------------------------------------------------*/
+
 // Computing the percentage or 'relative' average between two numbers is
 // very common and always needs to be guarded against division by zero.
 // Therefore we factor out this check into two simple function which also
@@ -937,27 +1491,79 @@ print_statistics (struct satch *solver, double seconds)
   if (verbose)
     printf ("c " F1 " %" L2 PRIu64 " %" L3 "s clauses\n", "added:",
 	    s.added, "");
+#ifndef NBLOCKED
+  printf ("c " F1 " %" L2 PRIu64 " %" P3 ".0f %%  added\n", "blocked:",
+	  s.blocked, percent (s.blocked, s.added));
+#endif
+  printf ("c " F1 " %" L2 PRIu64 " %" L3 ".2f per conflict\n", "bumped:",
+	  s.bumped, relative (s.bumped, s.conflicts));
+#ifndef NCOMPACT
+  printf ("c " F1 " %" L2 PRIu64 " %" P3 ".0f %%  fixed\n", "compacted:",
+	  s.compacted, percent (s.compacted, s.fixed));
+  printf ("c " F1 " %" L2 PRIu64 " %" L3 ".2f interval\n", "compactions:",
+	  s.compactions, relative (s.conflicts, s.compactions));
+#endif
+#ifdef COMPRESS
+  printf ("c " F1 " %" L2 PRIu64 " %" P3 ".0f %%  added\n", "compressed:",
+	  s.compressed, percent (s.compressed, s.added));
+  printf ("c " F1 " %" L2 PRIu64 " %" P3 ".0f %%  uncompressed\n",
+	  "compressed_bytes:", s.compressed_bytes,
+	  percent (s.compressed_bytes, s.uncompressed_bytes));
+#endif
   printf ("c " F1 " %" L2 PRIu64 " %" L3 ".2f per second\n", "conflicts:",
 	  s.conflicts, relative (s.conflicts, seconds));
+#ifndef NBLOCKED
+  printf ("c " F1 " %" L2 PRIu64 " %" P3 ".0f %%  added\n", "covered:",
+	  s.covered, percent (s.covered, s.added));
+#endif
   printf ("c " F1 " %" L2 PRIu64 " %" L3 ".2f per conflict\n", "decisions:",
 	  s.decisions, relative (s.decisions, s.conflicts));
   printf ("c " F1 " %" L2 PRIu64 " %" L3 ".2f literals\n", "deduced:",
 	  s.deduced, relative (s.deduced, s.conflicts));
+  if (solver->options.deduplicate)
+    printf ("c " F1 " %" L2 PRIu64 " %" P3 ".0f %%  added\n",
+	    "deduplicated:", s.deduplicated,
+	    percent (s.deduplicated, s.added));
   if (verbose)
     printf ("c " F1 " %" L2 PRIu64 " %" P3 ".0f %%  added\n", "deleted:",
 	    s.deleted, percent (s.deleted, s.added));
+#ifndef NTRANSITIVE
+  printf ("c " F1 " %" L2 PRIu64 " %" P3 ".0f %%  added\n", "duplicated:",
+	  s.duplicated, percent (s.duplicated, s.added));
+#endif
+#ifndef NBLOCKED
+  printf ("c " F1 " %" L2 PRIu64 " %" L3 ".2f interval\n", "eliminations:",
+	  s.eliminations, relative (s.conflicts, s.eliminations));
+#endif
   printf ("c " F1 " %" L2 PRIu64 " %" L3 ".2f literals\n", "learned:",
 	  s.learned, relative (s.learned, s.conflicts));
 #ifndef NMINIMIZE
   printf ("c " F1 " %" L2 PRIu64 " %" P3 ".0f %%  deduced\n", "minimized:",
 	  s.minimized, percent (s.minimized, s.deduced));
+#endif
+#ifndef NREDUCE
+  printf ("c " F1 " %" L2 PRIu64 " %" P3 ".0f %%  conflicts\n", "promoted:",
+	  s.promoted, percent (s.promoted, s.conflicts));
+#endif
+#ifndef NRESTART
+  printf ("c " F1 " %" L2 PRIu64 " %" P3 ".0f %%  conflicts\n", "postponed:",
+	  s.postponed, percent (s.postponed, s.conflicts));
 #endif
   printf ("c " F1 " %" L2 PRIu64 " %" L3 ".2f per second\n", "propagations:",
 	  s.propagations, relative (s.propagations, seconds));
+#ifndef NBUMPREASONS
+  printf ("c " F1 " %" L2 PRIu64 " %" P3 ".0f %%  bumped\n", "reasons:",
+	  s.reasons, percent (s.reasons, s.bumped));
+#endif
 #ifndef NREDUCE
   printf ("c " F1 " %" L2 PRIu64 " %" L3 ".2f interval\n", "reductions:",
 	  s.reductions, relative (s.conflicts, s.reductions));
 #endif
+#ifndef NSPILL
+  if (solver->options.spill_clauses)
+    printf ("c " F1 " %" L2 PRIu64 " %" P3 ".0f %%  spilled\n",
+	    "reloaded:", s.reloaded, percent (s.reloaded, s.spilled));
+#endif
 #ifndef NRESTART
   printf ("c " F1 " %" L2 PRIu64 " %" L3 ".2f interval\n", "restarts:",
 	  s.restarts, relative (s.conflicts, s.restarts));
@@ -965,9 +1571,34 @@ print_statistics (struct satch *solver, double seconds)
   printf ("c " F1 " %" L2 PRIu64 " %" L3 ".2f interval\n", "switched:",
 	  s.switched, relative (s.conflicts, s.switched));
 #endif
+#endif
+#ifndef NSTRENGTHEN
+  printf ("c " F1 " %" L2 PRIu64 " %" P3 ".0f %%  conflicts\n",
+	  "strengthened:", s.strengthened,
+	  percent (s.strengthened, s.conflicts));
+#endif
+#ifndef NSPILL
+  if (solver->options.spill_clauses)
+    printf ("c " F1 " %" L2 PRIu64 " %" P3 ".0f %%  added\n", "spilled:",
+	    s.spilled, percent (s.spilled, s.added));
+#endif
+#ifndef NSUBSUME
+  printf ("c " F1 " %" L2 PRIu64 " %" P3 ".0f %%  conflicts\n", "subsumed:",
+	  s.subsumed, percent (s.subsumed, s.conflicts));
 #endif
   printf ("c " F1 " %" L2 PRIu64 " %" L3 ".2f per prop\n", "ticks:",
 	  s.ticks, relative (s.ticks, s.propagations));
+#ifndef NTRANSITIVE
+  printf ("c " F1 " %" L2 PRIu64 " %" P3 ".0f %%  added\n",
+	  "transitive_reduced:", s.transitive_reduced,
+	  percent (s.transitive_reduced, s.added));
+  printf ("c " F1 " %" L2 PRIu64 " %" L3 ".2f interval\n",
+	  "transitive_reductions:", s.transitive_reductions,
+	  relative (s.conflicts, s.transitive_reductions));
+  printf ("c " F1 " %" L2 PRIu64 " %" P3 ".0f %%  fixed\n",
+	  "transitive_units:", s.transitive_units,
+	  percent (s.transitive_units, s.fixed));
+#endif
 }
 
 static void
@@ -977,23 +1608,31 @@ print_resource_usage (struct satch *solver, double seconds)
   const uint64_t memory = maximum_resident_set_size ();
   printf ("c %-27s %17" PRIu64 " bytes %11.2f MB\n",
 	  "memory:", memory, memory / (double) (1 << 20));
+  if (solver->options.huge_pages)
+    printf ("c %-27s %17" PRIu64 " pages\n",
+	    "huge-pages:", huge_pages_in_use ());
   printf ("c %-27s %17s %17.2f seconds\n", "time:", "", seconds);
 }
 
 /*------------------------------------------------------------------------*/
 
-// Export internal unsigned literals as external signed literals.
+// Export internal unsigned literals as signed literals for the internal
+// proof checker.  Its variables are the positions of the external variables
+// on the 'imports' stack plus one, which keeps them dense even for sparse
+// external variables (see 'import_literal') and unaffected by renumbering
+// internal variables (see 'compact_variables').
 
 #ifndef NDEBUG
 
-static unsigned
-export_literal (unsigned ilit)
+static int
+export_literal (struct satch *solver, unsigned ilit)
 {
   const unsigned iidx = INDEX (ilit);
-  assert (iidx < (unsigned) INT_MAX - 1);
-  const int eidx = iidx + 1;
-  const int elit = SIGN (ilit) ? -eidx : eidx;
-  return elit;
+  assert (iidx < solver->size);
+  const int cidx = solver->exported[iidx];
+  assert (0 < cidx);
+  const int clit = SIGN (ilit) ? -cidx : cidx;
+  return clit;
 }
 
 #endif
@@ -1006,42 +1645,278 @@ bytes_clause (size_t size)
   return sizeof (struct clause) + size * sizeof (unsigned);
 }
 
-static struct clause *
-add_clause (struct satch *solver, bool redundant, unsigned glue)
+#ifdef COMPRESS
+
+// Encoding the sorted tail literals of a clause.  The encoded size of a
+// subset of sorted literals is never larger than the encoded size of all
+// literals, since a difference needs at most one more byte than each of
+// the two differences it replaces.  Therefore if enough bytes are reserved
+// for the encoding of all literals of a clause, literals can be exchanged
+// between the plain and the encoded part and removed in place.  Only
+// renumbering literals during compaction might need more bytes (see
+// 'map_clauses').
+
+static size_t
+bytes_encoded (unsigned delta)
 {
-  const uint64_t added = INC (added);
-  const size_t size = SIZE (solver->clause);
-  assert (size > 1);
-  const size_t bytes = bytes_clause (size);
-  struct clause *res = malloc (bytes);
-  if (!res)
-    out_of_memory (bytes);
-  res->id = added;
-  res->garbage = false;
-  res->protected = false;
-  res->redundant = redundant;
-  res->used = false;
-  res->glue = glue;
-  res->size = size;
-  memcpy (res->literals, solver->clause.begin, size * sizeof (unsigned));
+  size_t res = 1;
+  while (delta >= 128)
+    delta >>= 7, res++;
   return res;
 }
 
-static struct clause *
-new_irredundant_clause (struct satch *solver)
+static int
+cmp_literals (const void *p, const void *q)
 {
-  struct clause *res = add_clause (solver, false, 0);
-  PUSH (solver->irredundant, res);
-  INC (irredundant);
-  return res;
+  const unsigned a = *(const unsigned *) p, b = *(const unsigned *) q;
+  return a < b ? -1 : a > b;
 }
 
-static struct clause *
-new_redundant_clause (struct satch *solver, unsigned glue)
+static size_t
+bytes_sorted (const unsigned *begin, const unsigned *end)
 {
-  struct clause *res = add_clause (solver, true, glue);
-#ifndef NLEARN
-  PUSH (solver->redundant, res);
+  size_t res = 0;
+  unsigned prev = 0;
+  for (const unsigned *p = begin; p != end; prev = *p++)
+    res += bytes_encoded (*p - prev);
+  return res;
+}
+
+// Bytes which need to be reserved for the tail of a clause with the given
+// literals (copied to 'decoded' to sort them).
+
+static size_t
+bytes_reserved (struct satch *solver, const unsigned *literals,
+		unsigned size)
+{
+  struct unsigned_stack *const decoded = &solver->decoded;
+  CLEAR (*decoded);
+  for (unsigned i = 0; i < size; i++)
+    PUSH (*decoded, literals[i]);
+  qsort (decoded->begin, size, sizeof (unsigned), cmp_literals);
+  return bytes_sorted (decoded->begin, decoded->end);
+}
+
+static size_t
+bytes_compressed (size_t reserved)
+{
+  return bytes_clause (compress_plain + 1) + reserved;
+}
+
+static size_t
+bytes_of_clause (const struct clause *c)
+{
+  if (c->compressed)
+    return bytes_compressed (*reserved_tail (c));
+  return bytes_clause (c->size);
+}
+
+// Sorts and encodes the tail literals which fit into the reserved bytes.
+
+static void
+encode_tail (struct clause *c, unsigned *begin, unsigned *end)
+{
+  qsort (begin, end - begin, sizeof (unsigned), cmp_literals);
+  assert (bytes_sorted (begin, end) <= *reserved_tail (c));
+  unsigned char *q = encoded_tail (c);
+  unsigned prev = 0;
+  for (const unsigned *p = begin; p != end; prev = *p++)
+    {
+      unsigned delta = *p - prev;
+      while (delta >= 128)
+	*q++ = (delta & 127) | 128, delta >>= 7;
+      *q++ = delta;
+    }
+}
+
+// Replace the literals of a compressed clause (thus 'literals' might be
+// reordered).  The size of the clause is only allowed to shrink.
+
+static void
+set_compressed_literals (struct clause *c, unsigned *literals,
+			 unsigned size)
+{
+  assert (c->compressed);
+  assert (size <= c->size);
+  c->size = size;
+  const unsigned plain = size < compress_plain ? size : compress_plain;
+  memcpy (c->literals, literals, plain * sizeof (unsigned));
+  encode_tail (c, literals + plain, literals + size);
+}
+
+static void
+decode_literals (struct satch *solver, const struct clause *c)
+{
+  struct unsigned_stack *const decoded = &solver->decoded;
+  CLEAR (*decoded);
+  for (all_literals_in_clause (lit, c))
+    PUSH (*decoded, lit);
+}
+
+// Exchange a literal in the encoded tail during propagation.
+
+static void
+replace_tail_literal (struct satch *solver, struct clause *c,
+		      unsigned old_lit, unsigned new_lit)
+{
+  decode_literals (solver, c);
+  unsigned *const begin = solver->decoded.begin + compress_plain;
+  unsigned *const end = solver->decoded.end;
+  unsigned *p = begin;
+  while (assert (p != end), *p != old_lit)
+    p++;
+  *p = new_lit;
+  encode_tail (c, begin, end);
+}
+
+#else
+
+static size_t
+bytes_of_clause (const struct clause *c)
+{
+  return bytes_clause (c->size);
+}
+
+#endif
+
+// Unless reduction is disabled clauses are bump-allocated in large blocks
+// of an arena.  Deleted clauses are not freed individually but their
+// memory is reclaimed during 'reduce' which moves all remaining clauses to
+// a new block (see 'move_clauses').  Without reduction learned clauses are
+// kept forever and thus clauses are simply allocated with 'malloc'.
+//
+// Clauses are always referenced by pointers (in watches, reasons and the
+// clause stacks) and never by 32-bit offsets into the arena.  All byte
+// counts are 'size_t' and clause counters are 64-bit.  Thus the total size
+// of the clause store is only limited by the available memory and it can
+// hold more than '2^32' literals.  The 'unsigned' size of a single clause
+// is enough, since clauses have neither duplicated nor complementary
+// literals and thus at most 'INT_MAX' literals.
+
+#ifndef NREDUCE
+
+static size_t
+arena_bytes (size_t bytes)
+{
+#ifdef NDEBUG
+  const size_t alignment = sizeof (unsigned);
+#else
+  const size_t alignment = sizeof (uint64_t);	// For 'clause->id'.
+#endif
+  return (bytes + alignment - 1) & ~(alignment - 1);
+}
+
+static void
+new_arena_block (struct satch *solver, size_t bytes)
+{
+  if (bytes < arena_block_size)
+    bytes = arena_block_size;
+  char *block;
+  if (solver->options.huge_pages)
+    {
+      bytes = huge_page_aligned (bytes);	// Padding is used as arena too.
+      block = allocate_huge_pages (bytes);
+    }
+  else if (!(block = malloc (bytes)))
+    out_of_memory (bytes);
+  PUSH (solver->arena.blocks, block);
+  solver->arena.top = block;
+  solver->arena.limit = block + bytes;
+  LOG ("allocated new arena block of %zu bytes", bytes);
+}
+
+static void *
+allocate_in_arena (struct satch *solver, size_t bytes)
+{
+  bytes = arena_bytes (bytes);
+  struct arena *const arena = &solver->arena;
+  if ((size_t) (arena->limit - arena->top) < bytes)
+    new_arena_block (solver, bytes);
+  void *res = arena->top;
+  arena->top += bytes;
+  return res;
+}
+
+static void
+release_arena_blocks (struct blocks *blocks)
+{
+  for (all_pointers_on_stack (char, block, *blocks))
+      free (block);
+  RELEASE (*blocks);
+}
+
+#endif
+
+static struct clause *
+add_clause (struct satch *solver, bool redundant, unsigned glue)
+{
+  INC (added);
+  const size_t size = SIZE (solver->clause);
+  assert (size > 1);
+#ifdef COMPRESS
+  const bool compressed = redundant && size >= compress_size;
+  const size_t reserved = compressed ?
+    bytes_reserved (solver, solver->clause.begin, size) : 0;
+  const size_t bytes = compressed ?
+    bytes_compressed (reserved) : bytes_clause (size);
+#else
+  const size_t bytes = bytes_clause (size);
+#endif
+#ifdef NREDUCE
+  struct clause *res = malloc (bytes);
+  if (!res)
+    out_of_memory (bytes);
+#else
+  struct clause *res = allocate_in_arena (solver, bytes);
+#endif
+#ifndef NDEBUG
+  res->id = solver->statistics.added;
+#endif
+  res->garbage = false;
+  res->protected = false;
+  res->redundant = redundant;
+  res->spilled = false;
+  res->used = 0;
+  res->glue = glue < MAX_GLUE ? glue : MAX_GLUE;
+  res->size = size;
+  res->compressed = false;
+#ifdef COMPRESS
+  if (compressed)
+    {
+      res->compressed = true;
+      *reserved_tail (res) = reserved;
+      memcpy (res->literals, solver->clause.begin,
+	      compress_plain * sizeof (unsigned));
+      struct unsigned_stack *const decoded = &solver->decoded;
+      CLEAR (*decoded);
+      for (size_t i = compress_plain; i < size; i++)
+	PUSH (*decoded, ACCESS (solver->clause, i));
+      encode_tail (res, decoded->begin, decoded->end);
+      INC (compressed);
+      ADD (compressed_bytes, bytes);
+      ADD (uncompressed_bytes, bytes_clause (size));
+      return res;
+    }
+#endif
+  memcpy (res->literals, solver->clause.begin, size * sizeof (unsigned));
+  return res;
+}
+
+static struct clause *
+new_irredundant_clause (struct satch *solver)
+{
+  struct clause *res = add_clause (solver, false, 0);
+  PUSH (solver->irredundant, res);
+  INC (irredundant);
+  return res;
+}
+
+static struct clause *
+new_redundant_clause (struct satch *solver, unsigned glue)
+{
+  struct clause *res = add_clause (solver, true, glue);
+#ifndef NLEARN
+  PUSH (solver->redundant, res);
 #endif
   INC (redundant);
   return res;
@@ -1053,16 +1928,21 @@ delete_clause (struct satch *solver, struct clause *c)
   INC (deleted);
   LOGCLS (c, "delete");
 #ifndef NDEBUG
-  for (all_literals_in_clause (lit, c))
-    checker_add (solver->checker, export_literal (lit));
-  checker_remove (solver->checker);
+  if (!c->spilled)		// Spilled clauses are kept in the checker.
+    {
+      for (all_literals_in_clause (lit, c))
+	checker_add (solver->checker, export_literal (solver, lit));
+      checker_remove (solver->checker);
+    }
 #endif
-  size_t bytes = bytes_clause (c->size);
+  size_t bytes = bytes_of_clause (c);
   if (c->redundant)
     DEC (redundant);
   else
     DEC (irredundant);
-  free (c);
+#ifdef NREDUCE
+  free (c);			// Otherwise reclaimed in 'move_clauses'.
+#endif
   return bytes;
 }
 
@@ -1123,16 +2003,15 @@ assign (struct satch *solver, unsigned lit, struct clause *reason)
       reason = 0;
     }
 
-  const unsigned not_lit = NOT (lit);
-  assert (!solver->values[lit]);
-  assert (!solver->values[not_lit]);
+  assert (!literal_value (solver->values, lit));
+  assert (!literal_value (solver->values, NOT (lit)));
 
-  // Set value of 'lit' and 'not-lit' independently in order to turn the
-  // code to access the value of a literal into a simple array look-up as
-  // well, thus it becomes simpler and branch less.
+  // Unless 'PACKED' is defined this sets the value of 'lit' and 'not-lit'
+  // independently in order to turn the code to access the value of a
+  // literal into a simple array look-up as well, thus it becomes simpler
+  // and branch less.
   //
-  solver->values[lit] = 1;
-  solver->values[not_lit] = -1;
+  set_value (solver->values, lit);
 
   const unsigned idx = INDEX (lit);
 
@@ -1215,7 +2094,7 @@ enqueue (struct satch *solver, unsigned idx)
     {
       LOG ("enqueued variable %u stamped %u", idx, link->stamp);
       const unsigned lit = LITERAL (idx);
-      if (!solver->values[lit])
+      if (!literal_value (solver->values, lit))
 	queue->search = idx;
     }
   else
@@ -1275,22 +2154,164 @@ dequeue (struct satch *solver, unsigned idx)
 // in the same process and clauses can be added incrementally without
 // forcing the user to define a maximum variable up-front.
 
+// With the 'reserve_memory' option variable and literal indexed arrays are
+// not reallocated when the capacity grows.  Instead address space for the
+// maximum capacity of '1u<<31' variables is reserved at the first
+// allocation with 'mmap' without access rights (and without reserving swap
+// space).  Increasing the capacity then only makes a larger prefix of the
+// arrays accessible with 'mprotect'.  Thus nothing is copied and pages are
+// only backed by (zeroed) memory when touched.  If reserving fails, for
+// instance due to 'ulimit -v', we fall back to reallocation.
+
+static size_t
+page_aligned (size_t bytes)
+{
+  static size_t page_size;
+  if (!page_size)
+    {
+      const long tmp = sysconf (_SC_PAGESIZE);
+      page_size = tmp > 0 ? tmp : 4096;
+    }
+  return (bytes + page_size - 1) & ~(page_size - 1);
+}
+
+// For huge pages we reserve one more huge page and unmap the unaligned
+// head and the remaining tail of the reserved address space.
+
+static void *
+reserve_memory (size_t bytes, bool huge)
+{
+  bytes = page_aligned (bytes);
+  const size_t padding = huge ? huge_page_size : 0;
+  char *res = mmap (0, bytes + padding, PROT_NONE,
+		    MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+  if (res == MAP_FAILED)
+    return 0;
+  if (huge)
+    {
+      char *aligned = (char *) huge_page_aligned ((size_t) res);
+      const size_t head = aligned - res;
+      if (head)
+	munmap (res, head);
+      if (padding - head)
+	munmap (aligned + bytes, padding - head);
+      advise_huge_pages (aligned, bytes);
+      res = aligned;
+    }
+  return res;
+}
+
+static void
+commit_memory (void *start, size_t bytes)
+{
+  if (mprotect (start, page_aligned (bytes), PROT_READ | PROT_WRITE))
+    out_of_memory (bytes);
+}
+
+static void
+unreserve_memory (void *start, size_t bytes)
+{
+  if (start)
+    munmap (start, page_aligned (bytes));
+}
+
+#define MAX_CAPACITY (1u<<31)
+
+#define RESERVED_ARRAYS \
+RESERVED_ARRAY (2, watches) \
+RESERVED_ARRAY (1, exported) \
+RESERVED_ARRAY (1, reasons) \
+RESERVED_ARRAY (1, links) \
+RESERVED_ARRAY (1, levels) \
+RESERVED_ARRAY (2, values) \
+RESERVED_ARRAY (1, saved) \
+RESERVED_ARRAY_IF_MODE (1, targets) \
+RESERVED_ARRAY (1, marks) \
+RESERVED_ARRAY (1, frames) \
+RESERVED_ARRAY (1, trail.begin)
+
+#ifdef NMODE
+#define RESERVED_ARRAY_IF_MODE(FACTOR,NAME) /**/
+#else
+#define RESERVED_ARRAY_IF_MODE RESERVED_ARRAY
+#endif
+
+static void
+release_variable_arrays (struct satch *solver)
+{
+#define RESERVED_ARRAY(FACTOR,NAME) \
+  if (solver->reserved) \
+    unreserve_memory (solver->NAME, \
+                      FACTOR * (size_t) MAX_CAPACITY * sizeof *solver->NAME); \
+  else \
+    free (solver->NAME); \
+  solver->NAME = 0;
+  RESERVED_ARRAYS
+#undef RESERVED_ARRAY
+  solver->reserved = false;
+}
+
+static bool
+reserve_variable_arrays (struct satch *solver)
+{
+  assert (!solver->capacity);
+  assert (!solver->reserved);
+  solver->reserved = true;
+#define RESERVED_ARRAY(FACTOR,NAME) \
+  if (!(solver->NAME = reserve_memory (FACTOR * (size_t) MAX_CAPACITY * \
+                                       sizeof *solver->NAME, \
+				       solver->options.huge_pages))) \
+    { \
+      release_variable_arrays (solver); \
+      return false; \
+    }
+  RESERVED_ARRAYS
+#undef RESERVED_ARRAY
+  solver->trail.end = solver->trail.propagate = solver->trail.begin;
+  return true;
+}
+
+static void *
+allocate_array (struct satch *solver, size_t bytes)
+{
+  void *res;
+  if (solver->options.huge_pages && bytes >= huge_page_size)
+    {
+      res = allocate_huge_pages (bytes);
+      memset (res, 0, bytes);
+    }
+  else if (!(res = calloc (bytes, 1)))
+    out_of_memory (bytes);
+  return res;
+}
+
 // The following macro increases the array 'NAME' in the solver which either
 // comes as variable indexed array ('FACTOR==1') or literal indexed array
 // ('FACTOR==2'). This reallocation would be more complex to code for signed
 // 'int' literals and is one of the reasons we use 'unsigned' literals.
+// The more general 'RESIZE_BYTES' is needed for 'values' which might be
+// packed (see 'bytes_values').
 
 #define RESIZE(FACTOR,NAME) \
 do { \
   const size_t size = sizeof *solver->NAME; \
-  const size_t old_bytes = FACTOR * (size_t) old_capacity * size; \
-  const size_t new_bytes = FACTOR * (size_t) new_capacity * size; \
-  void * chunk = calloc (new_bytes, 1); \
-  if (!chunk) \
-    out_of_memory (new_bytes); \
-  memcpy (chunk, solver->NAME, old_bytes); \
-  free (solver->NAME); \
-  solver->NAME = chunk; \
+  RESIZE_BYTES (NAME, FACTOR * (size_t) old_capacity * size, \
+                FACTOR * (size_t) new_capacity * size); \
+} while (0)
+
+#define RESIZE_BYTES(NAME,OLD_BYTES,NEW_BYTES) \
+do { \
+  const size_t old_bytes = (OLD_BYTES); \
+  const size_t new_bytes = (NEW_BYTES); \
+  if (solver->reserved) \
+    commit_memory (solver->NAME, new_bytes); \
+  else \
+    { \
+      void * chunk = allocate_array (solver, new_bytes); \
+      memcpy (chunk, solver->NAME, old_bytes); \
+      free (solver->NAME); \
+      solver->NAME = chunk; \
+    } \
 } while (0)
 
 // In principle we could use an unsigned stack for the trail but we can also
@@ -1326,16 +2347,27 @@ increase_capacity (struct satch *solver, unsigned new_capacity)
   const unsigned old_capacity = solver->capacity;
   LOG ("increasing capacity from %u to %u", old_capacity, new_capacity);
   assert (old_capacity < new_capacity);
-  assert (new_capacity <= 1u << 31);
+  assert (new_capacity <= MAX_CAPACITY);
+  if (!old_capacity && solver->options.reserve_memory &&
+      !reserve_variable_arrays (solver))
+    message (solver, 1, "could not reserve memory for variables");
   RESIZE (2, watches);
+  RESIZE (1, exported);
   RESIZE (1, reasons);
   RESIZE (1, links);
   RESIZE (1, levels);
-  RESIZE (2, values);
+  RESIZE_BYTES (values, bytes_values (old_capacity),
+		bytes_values (new_capacity));
   RESIZE (1, saved);
+#ifndef NMODE
+  RESIZE (1, targets);
+#endif
   RESIZE (1, marks);
   RESIZE (1, frames);
-  resize_trail (&solver->trail, new_capacity);
+  if (solver->reserved)
+    commit_memory (solver->trail.begin, new_capacity * sizeof (unsigned));
+  else
+    resize_trail (&solver->trail, new_capacity);
   solver->capacity = new_capacity;
 }
 
@@ -1383,6 +2415,34 @@ increase_size (struct satch *solver, unsigned new_size)
 
 /*------------------------------------------------------------------------*/
 
+// Marking literals with their sign in the variable indexed 'marks' array
+// allows to check for duplicated literals, tautological clauses and
+// resolvents quickly.  Note that 'analyze' uses the same array but with
+// different flags.
+
+static inline signed char
+marked_literal (struct satch *solver, unsigned lit)
+{
+  signed char res = solver->marks[INDEX (lit)];
+  if (SIGN (lit))
+    res = -res;
+  return res;
+}
+
+static inline void
+mark_literal (struct satch *solver, unsigned lit)
+{
+  solver->marks[INDEX (lit)] = SIGN (lit) ? -1 : 1;
+}
+
+static inline void
+unmark_literal (struct satch *solver, unsigned lit)
+{
+  solver->marks[INDEX (lit)] = 0;
+}
+
+/*------------------------------------------------------------------------*/
+
 // Checks whether the imported clause contains a literal and its negation.
 // If this is not the case this function also removes duplicated literals.
 
@@ -1399,7 +2459,7 @@ imported_clause_trivial_or_satisfied (struct satch *solver)
   for (const unsigned *p = begin_clause; p != end_clause; p++)
     {
       const unsigned lit = *p;
-      const signed value = values[lit];
+      const signed value = literal_value (values, lit);
       if (value < 0)
 	{
 	  LOG ("skipping falsified literal %u", lit);
@@ -1439,66 +2499,296 @@ imported_clause_trivial_or_satisfied (struct satch *solver)
 
 /*------------------------------------------------------------------------*/
 
-// 'elit' signed external literal (as in API and DIMACS format)
-// 'eidx' signed external variable index (in the range '1...INT_MAX')
-// 'iidx' unsigned internal variable index (in the range '0...(INT_MAX-1)')
-// 'ilit' unsigned internal literal (in the range '0...2*(INT_MAX-1)+1')
+// Exact duplicates of imported clauses are removed during import if the
+// 'deduplicate' option is set.  Each imported clause is fingerprinted by
+// an order independent hash of its literals (the sum of mixed literals,
+// which avoids sorting them) and stored in an open addressing hash table
+// with linear probing and a load factor of at most one half.  The table
+// is not enlarged beyond 'deduplicate_memory' megabytes after which
+// further clauses are only checked but not hashed anymore.  Since clauses
+// are moved during solving the table is released before solving.
 
-static unsigned
-import_literal (struct satch *solver, int elit)
+static uint64_t
+hash_literal (unsigned lit)
 {
-  assert (elit);
-  assert (elit != INT_MIN);	// otherwise '-elit' might be undefined
-  const int eidx = abs (elit);
-  const unsigned iidx = eidx - 1;
-  if (iidx >= solver->size)
-    increase_size (solver, iidx + 1);
-  unsigned ilit = LITERAL (iidx);
-  if (elit < 0)
-    ilit = NOT (ilit);
-  LOG ("imported external literal %d as internal literal %u", elit, ilit);
-  return ilit;
+  uint64_t res = lit + 0x9e3779b97f4a7c15ull;
+  res ^= res >> 30;
+  res *= 0xbf58476d1ce4e5b9ull;
+  res ^= res >> 27;
+  res *= 0x94d049bb133111ebull;
+  res ^= res >> 31;
+  return res;
 }
 
-/*------------------------------------------------------------------------*/
-
-// Propagating a literal over the clauses in which it occurs negatively,
-// more precisely for which its negation is  watched is the hot-spot of
-// CDCL solving.  This is pronounced by learning many long clauses.   
-
-static struct clause *
-propagate_literal (struct satch *solver, unsigned lit)
+static uint64_t
+hash_imported_clause (struct satch *solver)
 {
-  LOG ("propagating %u", lit);
+  uint64_t res = SIZE (solver->clause);
+  for (all_elements_on_stack (unsigned, lit, solver->clause))
+      res += hash_literal (lit);
+  return res;
+}
 
-  const unsigned not_lit = NOT (lit);
-  struct watches *const watches = solver->watches + not_lit;
-  signed char *const values = solver->values;
+static struct fingerprint *
+find_empty_fingerprint (struct fingerprints *fingerprints, uint64_t hash)
+{
+  const size_t mask = fingerprints->size - 1;
+  struct fingerprint *const table = fingerprints->table;
+  size_t pos = hash & mask;
+  while (table[pos].clause)
+    pos = (pos + 1) & mask;
+  return table + pos;
+}
 
-  // We traverse all the watches of the literal 'not_lit' and remove those
-  // for which we stop watching the clause (since we found a replacement).
-  // The updated watches pointers 'q' follows the traversal pointer 'p'.
-  //
-  struct watch *q = watches->begin;
-  const struct watch *p = q;
+static bool
+enlarge_fingerprints (struct satch *solver)
+{
+  struct fingerprints *const fingerprints = &solver->fingerprints;
+  if (fingerprints->full)
+    return false;
+  const size_t old_size = fingerprints->size;
+  const size_t new_size = old_size ? 2 * old_size : 1024;
+  const size_t bytes = new_size * sizeof (struct fingerprint);
+  const size_t limit = (size_t) solver->options.deduplicate_memory << 20;
+  if (bytes > limit)
+    {
+      message (solver, 1, "clause hash table limit of %zu MB reached",
+	       limit >> 20);
+      fingerprints->full = true;
+      return false;
+    }
+  LOG ("enlarging clause hash table to %zu entries", new_size);
+  struct fingerprint *const old_table = fingerprints->table;
+  fingerprints->table = calloc (new_size, sizeof (struct fingerprint));
+  if (!fingerprints->table)
+    out_of_memory (bytes);
+  fingerprints->size = new_size;
+  for (size_t pos = 0; pos != old_size; pos++)
+    {
+      const struct fingerprint fingerprint = old_table[pos];
+      if (fingerprint.clause)
+	*find_empty_fingerprint (fingerprints, fingerprint.hash) =
+	  fingerprint;
+    }
+  free (old_table);
+  return true;
+}
 
-  struct clause *conflict = 0;
+// Hash an irredundant clause just imported from the literals in 'clause'.
 
-  const struct watch *const end_watches = watches->end;
+static void
+fingerprint_imported_clause (struct satch *solver, struct clause *c)
+{
+  struct fingerprints *const fingerprints = &solver->fingerprints;
+  if (2 * (fingerprints->count + 1) > fingerprints->size &&
+      !enlarge_fingerprints (solver))
+    return;
+  const uint64_t hash = hash_imported_clause (solver);
+  struct fingerprint *const slot = find_empty_fingerprint (fingerprints,
+							   hash);
+  slot->hash = hash;
+  slot->clause = c;
+  fingerprints->count++;
+}
 
-  // Approximate the number of cache lines read in 'propagation' only
-  // focusing on accessing watch stacks, watches, clauses and assignments.
-  //
-  uint64_t ticks = 1 + (end_watches - q) / (128 / sizeof *q);
+// Checks whether the imported clause (after removing falsified and
+// duplicated literals) has the same literals as a previously hashed one.
 
-  while (!conflict && p != end_watches)
+static bool
+imported_clause_duplicated (struct satch *solver)
+{
+  const struct fingerprints *const fingerprints = &solver->fingerprints;
+  if (!fingerprints->count)
+    return false;
+  const uint64_t hash = hash_imported_clause (solver);
+  const size_t size = SIZE (solver->clause);
+  const size_t mask = fingerprints->size - 1;
+  const struct fingerprint *const table = fingerprints->table;
+  bool marked = false, res = false;
+  for (size_t pos = hash & mask; !res && table[pos].clause;
+       pos = (pos + 1) & mask)
+    {
+      struct clause *const c = table[pos].clause;
+      if (table[pos].hash != hash || c->size != size)
+	continue;
+      if (!marked)
+	{
+	  for (all_elements_on_stack (unsigned, lit, solver->clause))
+	      mark_literal (solver, lit);
+	  marked = true;
+	}
+      res = true;
+      for (all_literals_in_clause (lit, c))
+	if (marked_literal (solver, lit) <= 0)
+	  {
+	    res = false;
+	    break;
+	  }
+    }
+  if (marked)
+    for (all_elements_on_stack (unsigned, lit, solver->clause))
+	unmark_literal (solver, lit);
+  return res;
+}
+
+static void
+release_fingerprints (struct satch *solver)
+{
+  struct fingerprints *const fingerprints = &solver->fingerprints;
+  free (fingerprints->table);
+  memset (fingerprints, 0, sizeof *fingerprints);
+}
+
+/*------------------------------------------------------------------------*/
+
+// 'elit' signed external literal (as in API and DIMACS format)
+// 'eidx' signed external variable index (in the range '1...INT_MAX')
+// 'iidx' unsigned internal variable index (in the range '0...(INT_MAX-1)')
+// 'ilit' unsigned internal literal (in the range '0...2*(INT_MAX-1)+1')
+
+// External variables can be sparse (for instance hashed identifiers in
+// generated encodings) and thus are not used as internal indices directly.
+// Instead a new external variable is mapped to the next internal variable
+// and pushed on the 'imports' stack.  Its position on this stack is stored
+// in an open addressing hash table with linear probing, which has a load
+// factor of at most one half.  Thus internal indices are dense and only
+// depend on the number of imported variables.  Without renumbering the
+// internal literal of an external variable never changes but
+// 'compact_variables' might map it to another internal literal.
+
+static unsigned
+hash_external (int eidx)
+{
+  unsigned res = eidx;
+  res ^= res >> 16;
+  res *= 0x45d9f3bu;
+  res ^= res >> 16;
+  res *= 0x45d9f3bu;
+  res ^= res >> 16;
+  return res;
+}
+
+// Returns the hash table slot of 'eidx' which is either empty ('INVALID')
+// or contains the position of 'eidx' on the 'imports' stack.
+
+static unsigned *
+find_import (struct satch *solver, int eidx)
+{
+  assert (solver->hashed);
+  const size_t mask = solver->hashed - 1;
+  const struct import *const imports = solver->imports.begin;
+  unsigned *const table = solver->table;
+  size_t pos = hash_external (eidx) & mask;
+  for (;;)
+    {
+      unsigned *const slot = table + pos;
+      if (*slot == INVALID || imports[*slot].external == eidx)
+	return slot;
+      pos = (pos + 1) & mask;
+    }
+}
+
+static void
+enlarge_import_table (struct satch *solver)
+{
+  const size_t new_hashed = solver->hashed ? 2 * solver->hashed : 16;
+  LOG ("enlarging import hash table to %zu entries", new_hashed);
+  const size_t bytes = new_hashed * sizeof (unsigned);
+  free (solver->table);
+  solver->table = malloc (bytes);
+  if (!solver->table)
+    out_of_memory (bytes);
+  memset (solver->table, 0xff, bytes);	// All slots 'INVALID'.
+  solver->hashed = new_hashed;
+  unsigned pos = 0;
+  for (all_elements_on_stack (struct import, import, solver->imports))
+      *find_import (solver, import.external) = pos++;
+}
+
+// Get internal literal of an external variable or 'INVALID' if the
+// external variable has not been imported yet.
+
+static unsigned
+imported_literal (struct satch *solver, int eidx)
+{
+  if (!solver->hashed)
+    return INVALID;
+  const unsigned pos = *find_import (solver, eidx);
+  if (pos == INVALID)
+    return INVALID;
+  return ACCESS (solver->imports, pos).internal;
+}
+
+static unsigned
+import_literal (struct satch *solver, int elit)
+{
+  assert (elit);
+  assert (elit != INT_MIN);	// otherwise '-elit' might be undefined
+  const int eidx = abs (elit);
+  unsigned ilit = imported_literal (solver, eidx);
+  if (ilit == INVALID)
+    {
+      const size_t imported = SIZE (solver->imports);
+      if (2 * (imported + 1) > solver->hashed)
+	enlarge_import_table (solver);
+      const unsigned iidx = solver->size;
+      increase_size (solver, iidx + 1);
+      solver->exported[iidx] = imported + 1;
+      ilit = LITERAL (iidx);
+      const struct import import = {.external = eidx,.internal = ilit };
+      *find_import (solver, eidx) = imported;
+      PUSH (solver->imports, import);
+      if (eidx > solver->maximum)
+	solver->maximum = eidx;
+      LOG ("imported new external variable %d as internal variable %u",
+	   eidx, iidx);
+    }
+  if (elit < 0)
+    ilit = NOT (ilit);
+  LOG ("imported external literal %d as internal literal %u", elit, ilit);
+  return ilit;
+}
+
+/*------------------------------------------------------------------------*/
+
+// Propagating a literal over the clauses in which it occurs negatively,
+// more precisely for which its negation is  watched is the hot-spot of
+// CDCL solving.  This is pronounced by learning many long clauses.   
+
+static struct clause *
+propagate_literal (struct satch *solver, unsigned lit)
+{
+  LOG ("propagating %u", lit);
+
+  const unsigned not_lit = NOT (lit);
+  struct watches *const watches = solver->watches + not_lit;
+  signed char *const values = solver->values;
+
+  // We traverse all the watches of the literal 'not_lit' and remove those
+  // for which we stop watching the clause (since we found a replacement).
+  // The updated watches pointers 'q' follows the traversal pointer 'p'.
+  //
+  struct watch *q = watches->begin;
+  const struct watch *p = q;
+
+  struct clause *conflict = 0;
+
+  const struct watch *const end_watches = watches->end;
+
+  // Approximate the number of cache lines read in 'propagation' only
+  // focusing on accessing watch stacks, watches, clauses and assignments.
+  //
+  uint64_t ticks = 1 + (end_watches - q) / (128 / sizeof *q);
+
+  while (!conflict && p != end_watches)
     {
       struct watch watch = *q++ = *p++;	// Keep watch by default.
 
       struct clause *clause = watch.clause;
 #ifndef NBLOCK
       const unsigned blocking_lit = watch.blocking;
-      const signed char blocking_value = values[blocking_lit];
+      const signed char blocking_value =
+	literal_value (values, blocking_lit);
 
       if (blocking_value > 0)	// No need to access watched clause
 	continue;		// since blocking literal true.
@@ -1534,7 +2824,6 @@ propagate_literal (struct satch *solver, unsigned lit)
 #else
 	  assert (clause->size > 2);
 #endif
-	  assert (!clause->garbage);
 
 	  unsigned *const literals = clause->literals;
 
@@ -1557,7 +2846,7 @@ propagate_literal (struct satch *solver, unsigned lit)
 	  // watched literal 'not_lit', which gives the other literal.
 	  //
 	  const unsigned other = literals[0] ^ literals[1] ^ not_lit;
-	  const signed char other_value = values[other];
+	  const signed char other_value = literal_value (values, other);
 
 	  // Another common situation is that the other watched literal in
 	  // that clause is different from the blocking literal, but is
@@ -1582,7 +2871,12 @@ propagate_literal (struct satch *solver, unsigned lit)
 #else
 	  const unsigned size = clause->size;
 #endif
+#ifdef COMPRESS
+	  const unsigned plain = clause->compressed ? compress_plain : size;
+	  const unsigned *const end_literals = literals + plain;
+#else
 	  const unsigned *const end_literals = literals + size;
+#endif
 
 	  // Now search for a non-false ('true' or unassigned) replacement
 	  // for the watched literal 'not_lit' starting with the third.
@@ -1595,11 +2889,29 @@ propagate_literal (struct satch *solver, unsigned lit)
 	  for (r = literals + 2; r != end_literals; r++)
 	    {
 	      replacement = *r;
-	      replacement_value = values[replacement];
+	      replacement_value = literal_value (values, replacement);
 	      if (replacement_value >= 0)
 		break;
 	    }
 
+#ifdef COMPRESS
+	  // Continue the search in the encoded tail of compressed clauses.
+	  //
+	  if (replacement_value < 0 && plain < size)
+	    {
+	      ticks++;
+	      unsigned offset = 0;
+	      for (unsigned i = plain; i != size; i++)
+		{
+		  replacement = next_literal (clause, i, &offset, replacement);
+		  replacement_value = literal_value (values, replacement);
+		  if (replacement_value >= 0)
+		    break;
+		}
+	      r = 0;		// Replacement is in the encoded tail.
+	    }
+#endif
+
 	  if (replacement_value > 0)	// replacement literal true thus
 	    {
 #ifndef NBLOCK
@@ -1619,7 +2931,12 @@ propagate_literal (struct satch *solver, unsigned lit)
 	      // Swap watched literal with its replacement.
 	      //
 	      literals[1] = replacement;
-	      *r = not_lit;
+#ifdef COMPRESS
+	      if (!r)
+		replace_tail_literal (solver, clause, replacement, not_lit);
+	      else
+#endif
+		*r = not_lit;
 
 	      watch_literal (solver, replacement, other, clause);
 	    }
@@ -1717,11 +3034,9 @@ backtrack (struct satch *solver, unsigned new_level)
       assert (solver->unassigned < solver->size);
       solver->unassigned++;
 
-      const unsigned not_lit = NOT (lit);
-      assert (values[lit] > 0);
-      assert (values[not_lit] < 0);
-      values[lit] = 0;
-      values[not_lit] = 0;
+      assert (literal_value (values, lit) > 0);
+      assert (literal_value (values, NOT (lit)) < 0);
+      reset_value (values, lit);
 #ifdef NLEARN
       struct clause *reason = reasons[idx];
       if (reason && reason->redundant)
@@ -1810,6 +3125,41 @@ init_averages (struct satch * solver)
 
 /*------------------------------------------------------------------------*/
 
+// Restart blocking as in Glucose.  If the trail at a conflict is much
+// larger than on average, then the solver might be close to a satisfying
+// assignment and restarting in focused mode is postponed.  This is checked
+// during conflict analysis before the trail average is updated.
+
+#ifndef NRESTART
+
+static void
+block_restart (struct satch *solver, unsigned trail_size)
+{
+  if (!solver->options.restart_blocking)
+    return;
+#ifndef NMODE
+  if (solver->stable)
+    return;
+#endif
+  if (CONFLICTS < restart_block_conflicts)
+    return;
+  const double average =
+    unbiased_slow_average (solver, solver->averages.trail);
+  if (trail_size <= restart_block_margin * average)
+    return;
+  const uint64_t limit = CONFLICTS + restart_block_delay;
+  if (solver->limits.restart >= limit)
+    return;
+  LOG ("trail size %u exceeds average %g thus postponing restart",
+       trail_size, average);
+  INC (postponed);
+  solver->limits.restart = limit;
+}
+
+#endif
+
+/*------------------------------------------------------------------------*/
+
 // Sorting the analyzed variable indices to be bumped with respect to their
 // stamp makes sure that they keep the same relative order after bumping
 // which empirically improves the effectiveness of the decision heuristic
@@ -1861,7 +3211,7 @@ minimize_literal (struct satch *solver, unsigned lit, unsigned depth)
     return true;		// analyzed thus removable (unless start)
   if (depth > minimize_depth)
     return false;		// avoid deep recursion
-  assert (solver->values[lit] < 0);
+  assert (literal_value (solver->values, lit) < 0);
   struct clause *const reason = solver->reasons[idx];
   if (!reason)
     return false;		// decisions can not be removed
@@ -1928,56 +3278,101 @@ minimize_deduced_clause (struct satch *solver)
 
 /*------------------------------------------------------------------------*/
 
-static bool
-analyze (struct satch *solver, struct clause *conflict)
-{
-  assert (!solver->inconsistent);
+// Redundant reason clauses used in conflict analysis are marked as used,
+// which protects them from being reduced in the next reduction.  Clauses
+// with small glue (after the update below) are protected for two
+// reductions ('used' is decremented in 'gather_reduce_candidates').  The
+// glue of a clause is computed at learning time but assigned literals
+// might since have moved to fewer decision levels.  In this case we update
+// the glue ('promoting' the clause) by counting the decision levels of the
+// literals in the reason clause.  The second bit of 'frames' is used to
+// count each decision level only once and reset in a second pass.  This
+// does not interfere with the first bit which marks levels in the deduced
+// clause in 'analyze'.
 
-  const unsigned conflict_level = solver->level;
-  if (!conflict_level)
+#ifndef NREDUCE
+
+static void
+update_reason_glue (struct satch *solver, struct clause *reason)
+{
+  if (!reason->redundant)
+    return;
+  unsigned glue = reason->glue;
+  if (glue > reduce_glue_limit)
     {
-      LOG ("learned empty clause");
-      solver->inconsistent = true;
-#ifndef NDEBUG
-      checker_learned (solver->checker);
-#endif
-      return false;
+      const unsigned *const levels = solver->levels;
+      signed char *const frames = solver->frames;
+      unsigned new_glue = 0;
+      for (all_literals_in_clause (lit, reason))
+	{
+	  const unsigned level = levels[INDEX (lit)];
+	  if (!level || (frames[level] & 2))
+	    continue;
+	  frames[level] |= 2;
+	  new_glue++;
+	}
+      for (all_literals_in_clause (lit, reason))
+	frames[levels[INDEX (lit)]] &= ~2;
+      if (new_glue < glue)
+	{
+	  LOGCLS (reason, "promoting to glue %u", new_glue);
+	  reason->glue = glue = new_glue;
+	  INC (promoted);
+	}
     }
+  reason->used = 1 + (glue <= reduce_used_glue);
+}
 
-  assert (EMPTY (solver->blocks));	// Decision levels analyzed.
-  assert (EMPTY (solver->clause));	// Clause learned.
-  assert (EMPTY (solver->seen));	// Analyzed literals.
+#endif
 
-  PUSH (solver->clause, INVALID);	// Reserve room for 1st UIP.
+// Reason side bumping also bumps the variables in the reasons of the
+// literals in the learned clause, which are not in the clause themselves
+// but were close to being part of the conflict.  In order to keep the cost
+// per conflict small we give up if more than 'bump_reasons_limit' such
+// variables are found.  After such a failure we skip reason side bumping
+// for an increasing number of conflicts, which is reduced again after a
+// successful attempt.  This adapts to instances where reasons are long.
+//
+// There is no variable scoring heap in this solver and thus the added
+// variables are simply bumped through the decision queue in both modes.
+
+#ifndef NBUMPREASONS
+
+static void
+bump_reason_side_literals (struct satch *solver)
+{
+  if (solver->limits.bump_reasons.delay)
+    {
+      solver->limits.bump_reasons.delay--;
+      return;
+    }
 
   signed char *const marks = solver->marks;
   const unsigned *const levels = solver->levels;
   struct clause *const *const reasons = solver->reasons;
-  signed char *frames = solver->frames;
 #ifndef NSORT
   const struct link *const links = solver->links;
 #endif
-  struct clause *reason = conflict;
-
-  const unsigned *t = solver->trail.end;
-  unsigned unresolved_on_current_level = 0;
-  unsigned uip;
+  const size_t before = SIZE (solver->seen);
+  const size_t limit = before + bump_reasons_limit;
+  bool failed = false;
 
-  for (;;)
+  for (all_elements_on_stack (unsigned, lit, solver->clause))
     {
-      assert (reason);
-      LOGCLS (reason, "analyzing");
-      reason->used = true;
-      for (all_literals_in_clause (lit, reason))
+      struct clause *const reason = reasons[INDEX (lit)];
+      if (!reason)
+	continue;
+      for (all_literals_in_clause (other, reason))
 	{
-	  const unsigned idx = INDEX (lit);
-	  const unsigned lit_level = levels[idx];
-	  if (!lit_level)
-	    continue;
-	  const signed char mark = marks[idx];
-	  assert (!mark || mark == SEEN);
-	  if (mark)
+	  const unsigned idx = INDEX (other);
+	  if (marks[idx] || !levels[idx])
 	    continue;
+	  if (SIZE (solver->seen) == limit)
+	    {
+	      failed = true;
+	      break;
+	    }
+	  LOG ("analyzing reason side literal %u", other);
 	  marks[idx] = SEEN;
 	  struct analyzed analyzed;
 	  analyzed.idx = idx;
@@ -1985,75 +3380,379 @@ analyze (struct satch *solver, struct clause *conflict)
 	  analyzed.stamp = links[idx].stamp;
 #endif
 	  PUSH (solver->seen, analyzed);
-	  LOG ("analyzing literal %u", lit);
-	  assert (solver->values[lit] < 0);
-	  if (lit_level < conflict_level)
-	    {
-	      if (!frames[lit_level])
-		{
-		  LOG ("analyzing decision level %u", lit_level);
-		  PUSH (solver->blocks, lit_level);
-		  frames[lit_level] = 1;
-		}
-	      PUSH (solver->clause, lit);
-	    }
-	  else
-	    unresolved_on_current_level++;
-	}
-      do
-	{
-	  assert (solver->trail.begin < t);
-	  uip = *--t;
 	}
-      while (!marks[INDEX (uip)]);
-      if (!--unresolved_on_current_level)
+      if (failed)
 	break;
-      reason = reasons[INDEX (uip)];
     }
-  LOG ("1st unique implication point %u", uip);
-  const unsigned not_uip = NOT (uip);
-  ACCESS (solver->clause, 0) = not_uip;
 
-  LOGTMP ("deduced");
-  unsigned size = SIZE (solver->clause);
-  ADD (deduced, size);
-  assert (size);
+  unsigned interval = solver->limits.bump_reasons.interval;
+  if (failed)
+    {
+      LOG ("too many reason side literals");
+      while (SIZE (solver->seen) > before)
+	marks[POP (solver->seen).idx] = 0;
+      interval = 2 * interval + 1;
+      if (interval > bump_reasons_max_delay)
+	interval = bump_reasons_max_delay;
+    }
+  else
+    {
+      ADD (reasons, SIZE (solver->seen) - before);
+      interval /= 2;
+    }
+  solver->limits.bump_reasons.interval = interval;
+  solver->limits.bump_reasons.delay = interval;
+}
 
-#ifndef NMINIMIZE
-  minimize_deduced_clause (solver);
-  LOGTMP ("minimized");
-  size = SIZE (solver->clause);
 #endif
 
-  const unsigned glue = SIZE (solver->blocks);
-  unsigned jump_level = 0;
-  for (all_elements_on_stack (unsigned, lit_level, solver->blocks))
+/*------------------------------------------------------------------------*/
+
+// Consecutive learned clauses often subsume each other, in particular if
+// the later one is a strengthened version of an earlier one.  References
+// to the last 'subsume_recent' learned clauses are kept in a ring and
+// checked against each new learned clause using the sign marks of its
+// literals.  Subsumed clauses are marked as garbage right away but stay
+// watched until the next garbage collection.  Before that they might still
+// propagate and become reasons, which is sound since they are implied,
+// and reduction brings such reasons back to life.  The ring is reset
+// whenever garbage clauses are deleted.
+
+#ifndef NSUBSUME
+
+static void
+eagerly_subsume_recent_clauses (struct satch *solver,
+				struct clause *learned)
+{
+  const unsigned size = learned->size;
+  for (all_literals_in_clause (lit, learned))
+    mark_literal (solver, lit);
+  struct clause **const recent = solver->recent;
+  for (unsigned i = 0; i != subsume_recent; i++)
     {
-      frames[lit_level] = 0;
-      if (lit_level != conflict_level && jump_level < lit_level)
-	jump_level = lit_level;
+      struct clause *const c = recent[i];
+      if (!c || c->garbage || c->size < size)
+	continue;
+      unsigned found = 0;
+      for (all_literals_in_clause (lit, c))
+	if (marked_literal (solver, lit) > 0 && ++found == size)
+	  break;
+      if (found < size)
+	continue;
+      LOGCLS (c, "eagerly subsumed thus marked garbage");
+      INC (subsumed);
+      c->garbage = true;
+      recent[i] = 0;
     }
-  CLEAR (solver->blocks);
+  for (all_literals_in_clause (lit, learned))
+    unmark_literal (solver, lit);
+  const unsigned next = solver->next_recent;
+  recent[next] = learned;
+  solver->next_recent = (next + 1 == subsume_recent) ? 0 : next + 1;
+}
 
-#ifndef NRESTART
-  update_fast_average (&solver->averages.fast_glue, glue);
-#endif
-  update_slow_average (&solver->averages.slow_glue, glue);
-  update_slow_average (&solver->averages.conflict_level, conflict_level);
-  update_betas (solver);
+#if !defined(NREDUCE) || !defined(NSIMPLIFY)
+
+static void
+reset_recent_clauses (struct satch *solver)
+{
+  memset (solver->recent, 0, sizeof solver->recent);
+  solver->next_recent = 0;
+}
 
-  LOG ("determined jump level %u and glue %u", jump_level, glue);
-  LOG ("exponential 'conflict_level' moving average %g",
-       unbiased_slow_average (solver, solver->averages.conflict_level));
-#ifndef NRESTART
-  LOG ("exponential 'fast_glue' moving average %g",
-       unbiased_fast_average (solver, solver->averages.fast_glue));
 #endif
-  LOG ("exponential 'slow_glue' moving average %g",
-       unbiased_slow_average (solver, solver->averages.slow_glue));
 
-#ifndef NSORT
-  sort_analyzed (solver);
+#endif
+
+/*------------------------------------------------------------------------*/
+
+// On-the-fly strengthening.  After resolving the current resolvent with
+// the reason of 'pivot' during conflict analysis, the resolvent contains
+// all literals of the reason except 'pivot'.  If the resolvent has exactly
+// one literal less than the reason (not counting root-level literals) then
+// both are the same and the reason can be strengthened in place by
+// removing 'pivot'.  The size of the resolvent is the number of literals
+// on lower decision levels added to the deduced clause so far plus the
+// number of unresolved literals on the conflict level.
+//
+// The strengthened clause is falsified.  We watch its two literals on the
+// highest decision levels, which makes sure that watches are valid again
+// after backtracking to the jump level of the clause learned in the end.
+// If only one of those literals is on the conflict level it is the 1st
+// UIP and the learned clause is a subset of the strengthened clause.
+
+#ifndef NSTRENGTHEN
+
+static void
+unwatch_literal (struct satch *solver, unsigned lit, struct clause *c)
+{
+  struct watches *const watches = solver->watches + lit;
+  struct watch *const end = watches->end;
+  struct watch *q = watches->begin;
+  for (struct watch * p = q; p != end; p++)
+    if ((*q++ = *p).clause == c)
+      q--;
+  assert (q + 1 == end);
+  watches->end = q;
+}
+
+static void
+strengthen_reason (struct satch *solver, struct clause *reason,
+		   unsigned pivot)
+{
+  LOGCLS (reason, "on-the-fly strengthening by removing %u", pivot);
+  INC (strengthened);
+
+  unsigned *literals = reason->literals;
+#ifdef COMPRESS
+  if (reason->compressed)
+    {
+      decode_literals (solver, reason);
+      literals = solver->decoded.begin;
+    }
+#endif
+  unwatch_literal (solver, literals[0], reason);
+  unwatch_literal (solver, literals[1], reason);
+
+  const unsigned *const end = literals + reason->size;
+  unsigned *q = literals;
+  for (const unsigned *p = literals; p != end; p++)
+    if (*p != pivot)
+      *q++ = *p;
+  assert (q + 1 == end);
+  const unsigned size = q - literals;
+  reason->size = size;
+  assert (size > 1);
+
+  const unsigned *const levels = solver->levels;
+  for (unsigned i = 0; i < 2; i++)
+    {
+      unsigned best = i;
+      unsigned best_level = levels[INDEX (literals[i])];
+      for (unsigned j = i + 1; j < size; j++)
+	{
+	  const unsigned level = levels[INDEX (literals[j])];
+	  if (level > best_level)
+	    best = j, best_level = level;
+	}
+      const unsigned lit = literals[best];
+      literals[best] = literals[i];
+      literals[i] = lit;
+    }
+#ifdef COMPRESS
+  if (reason->compressed)
+    set_compressed_literals (reason, literals, size);
+#endif
+  watch_clause (solver, reason);
+
+  LOGCLS (reason, "on-the-fly strengthened");
+#ifndef NDEBUG
+  for (all_literals_in_clause (lit, reason))
+    checker_add (solver->checker, export_literal (solver, lit));
+  checker_learned (solver->checker);
+  for (all_literals_in_clause (lit, reason))
+    checker_add (solver->checker, export_literal (solver, lit));
+  checker_add (solver->checker, export_literal (solver, pivot));
+  checker_remove (solver->checker);
+#endif
+}
+
+#endif
+
+/*------------------------------------------------------------------------*/
+
+// Target phases are the values of the largest conflict free assignment
+// since the last restart, which consists of all assigned literals below
+// the conflict level.  Using them as decision phases in stable mode drives
+// the solver towards that assignment which helps on satisfiable instances.
+
+#ifndef NMODE
+
+static void
+update_target_phases (struct satch *solver, unsigned conflict_level)
+{
+  const unsigned *const levels = solver->levels;
+  const unsigned *const begin = solver->trail.begin;
+  const unsigned *end = solver->trail.end;
+  while (end != begin && levels[INDEX (end[-1])] == conflict_level)
+    end--;
+  const unsigned size = end - begin;
+  if (size <= solver->target)
+    return;
+  LOG ("updating target assignment of size %u", size);
+  signed char *const targets = solver->targets;
+  for (const unsigned *p = begin; p != end; p++)
+    {
+      const unsigned lit = *p;
+      targets[INDEX (lit)] = SIGN (lit) ? -1 : 1;
+    }
+  solver->target = size;
+}
+
+#endif
+
+/*------------------------------------------------------------------------*/
+
+static bool
+analyze (struct satch *solver, struct clause *conflict)
+{
+  assert (!solver->inconsistent);
+
+  const unsigned conflict_level = solver->level;
+#ifndef NRESTART
+  const unsigned trail_size = SIZE (solver->trail);
+#endif
+  if (!conflict_level)
+    {
+      LOG ("learned empty clause");
+      solver->inconsistent = true;
+#ifndef NDEBUG
+      checker_learned (solver->checker);
+#endif
+      return false;
+    }
+
+  assert (EMPTY (solver->blocks));	// Decision levels analyzed.
+  assert (EMPTY (solver->clause));	// Clause learned.
+  assert (EMPTY (solver->seen));	// Analyzed literals.
+
+  PUSH (solver->clause, INVALID);	// Reserve room for 1st UIP.
+
+  signed char *const marks = solver->marks;
+  const unsigned *const levels = solver->levels;
+  struct clause *const *const reasons = solver->reasons;
+  signed char *frames = solver->frames;
+#ifndef NSORT
+  const struct link *const links = solver->links;
+#endif
+  struct clause *reason = conflict;
+
+  const unsigned *t = solver->trail.end;
+  unsigned unresolved_on_current_level = 0;
+  unsigned uip = INVALID;
+
+  for (;;)
+    {
+      assert (reason);
+      LOGCLS (reason, "analyzing");
+#ifndef NREDUCE
+      update_reason_glue (solver, reason);
+#endif
+#ifndef NSTRENGTHEN
+      unsigned reason_size = 0;
+#endif
+      for (all_literals_in_clause (lit, reason))
+	{
+	  const unsigned idx = INDEX (lit);
+	  const unsigned lit_level = levels[idx];
+	  if (!lit_level)
+	    continue;
+#ifndef NSTRENGTHEN
+	  reason_size++;
+#endif
+	  const signed char mark = marks[idx];
+	  assert (!mark || mark == SEEN);
+	  if (mark)
+	    continue;
+	  marks[idx] = SEEN;
+	  struct analyzed analyzed;
+	  analyzed.idx = idx;
+#ifndef NSORT
+	  analyzed.stamp = links[idx].stamp;
+#endif
+	  PUSH (solver->seen, analyzed);
+	  LOG ("analyzing literal %u", lit);
+	  assert (literal_value (solver->values, lit) < 0);
+	  if (lit_level < conflict_level)
+	    {
+	      if (!frames[lit_level])
+		{
+		  LOG ("analyzing decision level %u", lit_level);
+		  PUSH (solver->blocks, lit_level);
+		  frames[lit_level] = 1;
+		}
+	      PUSH (solver->clause, lit);
+	    }
+	  else
+	    unresolved_on_current_level++;
+	}
+#ifndef NSTRENGTHEN
+      if (reason != conflict && reason->size > 2 && !reason->garbage &&
+#ifdef NLEARN
+	  !reason->redundant &&	// Not watched and deleted eagerly.
+#endif
+	  SIZE (solver->clause) - 1 + unresolved_on_current_level <
+	  reason_size)
+	strengthen_reason (solver, reason, uip);
+#endif
+      do
+	{
+	  assert (solver->trail.begin < t);
+	  uip = *--t;
+	}
+      while (!marks[INDEX (uip)]);
+      if (!--unresolved_on_current_level)
+	break;
+      reason = reasons[INDEX (uip)];
+    }
+  LOG ("1st unique implication point %u", uip);
+  const unsigned not_uip = NOT (uip);
+  ACCESS (solver->clause, 0) = not_uip;
+
+  LOGTMP ("deduced");
+  unsigned size = SIZE (solver->clause);
+  ADD (deduced, size);
+  assert (size);
+
+#ifndef NMINIMIZE
+  minimize_deduced_clause (solver);
+  LOGTMP ("minimized");
+  size = SIZE (solver->clause);
+#endif
+
+  const unsigned glue = SIZE (solver->blocks);
+  unsigned jump_level = 0;
+  for (all_elements_on_stack (unsigned, lit_level, solver->blocks))
+    {
+      frames[lit_level] = 0;
+      if (lit_level != conflict_level && jump_level < lit_level)
+	jump_level = lit_level;
+    }
+  CLEAR (solver->blocks);
+
+#ifndef NRESTART
+  update_fast_average (&solver->averages.fast_glue, glue);
+#endif
+  update_slow_average (&solver->averages.slow_glue, glue);
+  update_slow_average (&solver->averages.conflict_level, conflict_level);
+#ifndef NRESTART
+  block_restart (solver, trail_size);
+  update_slow_average (&solver->averages.trail, trail_size);
+#endif
+#ifndef NMODE
+  solver->limits.mode.progress.glue += glue;
+  if (trail_size > solver->limits.mode.progress.trail)
+    solver->limits.mode.progress.trail = trail_size;
+#endif
+  update_betas (solver);
+
+  LOG ("determined jump level %u and glue %u", jump_level, glue);
+  LOG ("exponential 'conflict_level' moving average %g",
+       unbiased_slow_average (solver, solver->averages.conflict_level));
+#ifndef NRESTART
+  LOG ("exponential 'fast_glue' moving average %g",
+       unbiased_fast_average (solver, solver->averages.fast_glue));
+#endif
+  LOG ("exponential 'slow_glue' moving average %g",
+       unbiased_slow_average (solver, solver->averages.slow_glue));
+
+#ifndef NBUMPREASONS
+  if (solver->options.bump_reasons)
+    bump_reason_side_literals (solver);
+#endif
+  ADD (bumped, SIZE (solver->seen));
+#ifndef NSORT
+  sort_analyzed (solver);
 #endif
   for (all_elements_on_stack (struct analyzed, analyzed, solver->seen))
     {
@@ -2066,6 +3765,10 @@ analyze (struct satch *solver, struct clause *conflict)
     }
   CLEAR (solver->seen);
 
+#ifndef NMODE
+  if (solver->stable && solver->options.target_phases)
+    update_target_phases (solver, conflict_level);
+#endif
   backtrack (solver, jump_level);
 
   if (size == 1)		// Learned a unit clause.
@@ -2103,11 +3806,14 @@ analyze (struct satch *solver, struct clause *conflict)
       watch_clause (solver, learned);
 #endif
       assign (solver, not_uip, learned);
+#ifndef NSUBSUME
+      eagerly_subsume_recent_clauses (solver, learned);
+#endif
     }
 
 #ifndef NDEBUG
   for (all_elements_on_stack (unsigned, lit, solver->clause))
-      checker_add (solver->checker, export_literal (lit));
+      checker_add (solver->checker, export_literal (solver, lit));
   checker_learned (solver->checker);
 #endif
   CLEAR (solver->clause);
@@ -2135,7 +3841,7 @@ decide (struct satch *solver)
     {
       assert (idx != INVALID);
       lit = LITERAL (idx);
-      const signed char value = values[lit];
+      const signed char value = literal_value (values, lit);
       if (!value)
 	break;
       idx = links[idx].prev;
@@ -2146,9 +3852,18 @@ decide (struct satch *solver)
   solver->level++;
   LOG ("decision variable %u stamped %u", idx, links[idx].stamp);
 
-  // Assign to saved previously assigned value.
+  // Assign to saved previously assigned value unless target phases are
+  // used in stable mode and the variable has a target value.
   //
-  const unsigned decision = lit ^ solver->saved[idx];
+  unsigned decision = lit ^ solver->saved[idx];
+#ifndef NMODE
+  if (solver->stable && solver->options.target_phases)
+    {
+      const signed char target = solver->targets[idx];
+      if (target)
+	decision = lit ^ (target < 0);
+    }
+#endif
   assign (solver, decision, 0);
 }
 
@@ -2345,7 +4060,7 @@ iterate (struct satch *solver)
 
 // Scaling functions used for scaling conflict intervals.
 
-#if !defined(NREDUCE) || !defined(NRESTART)
+#if !defined(NREDUCE) || !defined(NRESTART) || !defined(NSIMPLIFY)
 
 static double
 logn (uint64_t n)
@@ -2366,7 +4081,7 @@ nlognlognlogn (uint64_t n)
 
 #endif
 
-#if !defined(NREDUCE)
+#if !defined(NREDUCE) || !defined(NSIMPLIFY)
 
 static double
 ndivlogn (uint64_t n)
@@ -2401,6 +4116,28 @@ restarting (struct satch *solver)
   return fast > limit;
 }
 
+#ifndef NMODE
+
+// The Luby sequence '1, 1, 2, 1, 1, 2, 4, 1, 1, 2, 1, 1, 2, 4, 8, ...'
+// used as alternative to inner-outer restart intervals in stable mode.
+
+static uint64_t
+luby_sequence (uint64_t i)
+{
+  assert (i > 0);
+  for (;;)
+    {
+      uint64_t power = 2;
+      while (power - 1 < i)
+	power *= 2;
+      if (power - 1 == i)
+	return power / 2;
+      i -= power / 2 - 1;
+    }
+}
+
+#endif
+
 static void
 restart (struct satch *solver)
 {
@@ -2412,10 +4149,18 @@ restart (struct satch *solver)
     report (solver, 'r');
 
   backtrack (solver, 0);
+#ifndef NMODE
+  solver->target = 0;
+#endif
 
   uint64_t interval;
 #ifndef NMODE
-  if (solver->stable)
+  if (solver->stable && solver->options.stable_restarts)
+    {
+      const uint64_t luby = ++solver->limits.mode.restarts.luby;
+      interval = inner_interval * luby_sequence (luby);
+    }
+  else if (solver->stable)
     {
       interval = solver->limits.mode.restarts.inner;
       solver->limits.mode.restarts.inner *= inner_outer_factor;
@@ -2441,43 +4186,13 @@ restart (struct satch *solver)
 
 /*------------------------------------------------------------------------*/
 
-// Reducing the clause data base by removing useless redundant clauses is
-// important to keep the memory usage of the solver low, but also to
-// speed-up propagation.  The reduction interval in terms of conflicts is
-// increased arithmetically by 'reduce_interval'.  We combine reductions
-// with clause data base simplifications which remove root-level satisfied
-// clauses.  Removing falsified literals is not implemented yet.
-
-#ifndef NREDUCE
-
-static bool
-reducing (struct satch *solver)
-{
-  return solver->limits.reduce.conflicts <= CONFLICTS;
-}
+// Clause reduction, blocked clause elimination and transitive reduction
+// all mark clauses as 'garbage' first, then flush the watches of garbage
+// clauses and finally delete the garbage clauses.
 
-// Protect reason clauses from garbage collection. The same function can
-// be used afterwards to make reason clauses unprotected again.  It is
-// better to lazily protect clauses during reductions instead of eagerly
-// setting the 'protect' bit during assignments to avoid dereferencing
-// pointers to binary clause reasons.
+#if !defined(NREDUCE) || !defined(NSIMPLIFY)
 
-static void
-set_protect_flag_of_reasons (struct satch *solver, bool protect)
-{
-  struct clause *const *const reasons = solver->reasons;
-  for (all_elements_on_stack (unsigned, lit, solver->trail))
-    {
-      const unsigned idx = INDEX (lit);
-      struct clause *reason = reasons[idx];
-      if (reason)
-	{
-	  LOGCLS (reason, "%sprotecting", protect ? "" : "un");
-	  assert (reason->protected != protect);
-	  reason->protected = protect;
-	}
-    }
-}
+#if !defined(NREDUCE) || !defined(NBLOCKED)
 
 static bool
 clause_root_level_satisfied (struct satch *solver, struct clause *c)
@@ -2485,72 +4200,12 @@ clause_root_level_satisfied (struct satch *solver, struct clause *c)
   const signed char *const values = solver->values;
   const unsigned *const levels = solver->levels;
   for (all_literals_in_clause (lit, c))
-    if (values[lit] > 0 && !levels[INDEX (lit)])
+    if (literal_value (values, lit) > 0 && !levels[INDEX (lit)])
       return true;
   return false;
 }
 
-// Irredundant clauses are not reduced but root-level satisfied clauses
-// can be collected during reduction too.  This is only necessary if there
-// are new root-level fixed variables since the last reduction though.
-
-static void
-mark_satisfied_irredundant_clauses_as_garbage (struct satch *solver)
-{
-  for (all_irredundant_clauses (c))
-    {
-      assert (!c->redundant);
-      assert (!c->garbage);
-      if (c->protected)
-	continue;
-      if (!clause_root_level_satisfied (solver, c))
-	continue;
-      LOGCLS (c, "root-level satisfied thus marked garbage");
-      assert (!c->garbage);
-      c->garbage = true;
-    }
-}
-
-// Redundant clauses with large enough glucose level (glue) which have not
-// been used since the last reduction are deletion candidates. If there
-// are new root-level fixed variables since the last reduction we also
-// mark clauses as garbage which are root-level satisfied too.
-
-static void
-gather_reduce_candidates (struct satch *solver, bool new_fixed_variables,
-			  struct clauses *candidates)
-{
-  for (all_redundant_clauses (c))
-    {
-      assert (c->redundant);
-      assert (!c->garbage);
-      if (c->protected)
-	continue;
-      if (new_fixed_variables && clause_root_level_satisfied (solver, c))
-	{
-	  LOGCLS (c, "root-level satisfied thus marked garbage");
-	  c->garbage = true;
-	  continue;
-	}
-      const bool used = c->used;
-      c->used = false;
-      if (used)
-	continue;
-      if (c->glue <= reduce_glue_limit)
-	continue;
-      PUSH (*candidates, c);
-    }
-
-  if (solver->options.verbose < 2)
-    return;
-
-  const size_t size_candidates = SIZE (*candidates);
-  const size_t redundant = SIZE (solver->redundant);
-  message (solver, 2, "[reduced-%" PRIu64 "] "
-	   "gathered %zu reduce candidate clauses %.0f%%",
-	   solver->statistics.reductions,
-	   size_candidates, percent (size_candidates, redundant));
-}
+#endif
 
 // Before actually deleting the garbage clauses we of course have to
 // flush watches from the watcher lists pointing to such garbage clauses.
@@ -2583,6 +4238,10 @@ delete_garbage_clauses (struct satch *solver, struct clauses *clauses,
   size_t bytes = 0;
   size_t count = 0;
 
+#ifndef NSUBSUME
+  reset_recent_clauses (solver);
+#endif
+
   struct clause *const *const end = clauses->end;
   struct clause **q = clauses->begin;
 
@@ -2604,18 +4263,260 @@ delete_garbage_clauses (struct satch *solver, struct clauses *clauses,
   *count_ptr += count;
 }
 
+#endif
+
+/*------------------------------------------------------------------------*/
+
+// Reducing the clause data base by removing useless redundant clauses is
+// important to keep the memory usage of the solver low, but also to
+// speed-up propagation.  The reduction interval in terms of conflicts is
+// increased arithmetically by 'reduce_interval'.  We combine reductions
+// with clause data base simplifications which remove root-level satisfied
+// clauses.  Removing falsified literals is not implemented yet.
+
+#ifndef NREDUCE
+
+struct candidate		// Reduce candidate clause.
+{
+  struct clause *clause;
+  size_t position;		// Position on 'redundant' stack.
+};
+
+struct candidates		// Stack of reduce candidates.
+{
+  struct candidate *begin, *end, *allocated;
+};
+
+static bool
+reducing (struct satch *solver)
+{
+  return solver->limits.reduce.conflicts <= CONFLICTS;
+}
+
+// Protect reason clauses from garbage collection. The same function can
+// be used afterwards to make reason clauses unprotected again.  It is
+// better to lazily protect clauses during reductions instead of eagerly
+// setting the 'protect' bit during assignments to avoid dereferencing
+// pointers to binary clause reasons.
+
+static void
+set_protect_flag_of_reasons (struct satch *solver, bool protect)
+{
+  struct clause *const *const reasons = solver->reasons;
+  for (all_elements_on_stack (unsigned, lit, solver->trail))
+    {
+      const unsigned idx = INDEX (lit);
+      struct clause *reason = reasons[idx];
+      if (reason)
+	{
+	  LOGCLS (reason, "%sprotecting", protect ? "" : "un");
+	  assert (reason->protected != protect);
+	  reason->protected = protect;
+#ifndef NSUBSUME
+	  if (reason->garbage)
+	    {
+	      assert (reason->redundant);
+	      LOGCLS (reason, "subsumed reason thus revived");
+	      reason->garbage = false;
+	    }
+#endif
+	}
+    }
+}
+
+// Irredundant clauses are not reduced but root-level satisfied clauses
+// can be collected during reduction too.  This is only necessary if there
+// are new root-level fixed variables since the last reduction though.
+
+static void
+mark_satisfied_irredundant_clauses_as_garbage (struct satch *solver)
+{
+  for (all_irredundant_clauses (c))
+    {
+      assert (!c->redundant);
+      assert (!c->garbage);
+      if (c->protected)
+	continue;
+      if (!clause_root_level_satisfied (solver, c))
+	continue;
+      LOGCLS (c, "root-level satisfied thus marked garbage");
+      assert (!c->garbage);
+      c->garbage = true;
+    }
+}
+
+// Learned clauses with small glue are kept by reductions, even if they
+// have not been used for a long time.  For huge and long running instances
+// these clauses can use more memory than available.  With 'spill_clauses'
+// those cold clauses of such low glue, which have not been used since the
+// last two reductions, are appended (size, glue and literals) to a
+// temporary file instead and then collected like garbage clauses.  They
+// are reloaded (by mapping the file into memory) at the next compaction
+// of variables, which rebuilds all watches anyhow and has to renumber the
+// literals of all clauses.  Since spilled clauses are still implied they
+// are not removed from the internal proof checker.
+
+#ifndef NSPILL
+
+static void
+spill_clause (struct satch *solver, struct clause *c)
+{
+  assert (c->redundant);
+  assert (!c->garbage);
+  assert (!c->protected);
+  struct spill *const spill = &solver->spill;
+  if (!spill->file && !(spill->file = tmpfile ()))
+    {
+      message (solver, 1, "could not open spill file");
+      solver->options.spill_clauses = 0;
+      return;
+    }
+  const unsigned header[2] = { c->size, c->glue };
+  if (fwrite (header, sizeof header, 1, spill->file) != 1)
+    fatal_error ("failed to write spill file");
+  for (all_literals_in_clause (lit, c))
+    if (fwrite (&lit, sizeof lit, 1, spill->file) != 1)
+      fatal_error ("failed to write spill file");
+  spill->bytes += sizeof header + c->size * sizeof (unsigned);
+  LOGCLS (c, "spilled");
+  c->garbage = true;
+  c->spilled = true;
+  INC (spilled);
+}
+
+static void
+reload_spilled_clauses (struct satch *solver)
+{
+  assert (!solver->level);
+  struct spill *const spill = &solver->spill;
+  const size_t bytes = spill->bytes;
+  if (!bytes)
+    return;
+  if (fflush (spill->file))
+    fatal_error ("failed to flush spill file");
+  unsigned *const begin = mmap (0, bytes, PROT_READ, MAP_PRIVATE,
+				fileno (spill->file), 0);
+  if (begin == MAP_FAILED)
+    fatal_error ("failed to map spill file");
+  const signed char *const values = solver->values;
+  const unsigned *const end = begin + bytes / sizeof (unsigned);
+  size_t reloaded = 0, dropped = 0;
+  for (const unsigned *p = begin, *next; p != end; p = next)
+    {
+      const unsigned size = p[0], glue = p[1];
+      const unsigned *const literals = p + 2;
+      next = literals + size;
+      bool satisfied = false;
+      unsigned unassigned = 0;
+      for (const unsigned *q = literals; !satisfied && q != next; q++)
+	{
+	  const signed char value = literal_value (values, *q);
+	  if (value > 0)
+	    satisfied = true;
+	  else if (!value)
+	    unassigned++;
+	}
+
+      // Reloaded clauses need two unassigned literals to be watched.  As
+      // all spilled clauses are redundant the others are just deleted.
+      //
+      if (satisfied || unassigned < 2)
+	{
+#ifndef NDEBUG
+	  for (const unsigned *q = literals; q != next; q++)
+	    checker_add (solver->checker, export_literal (solver, *q));
+	  checker_remove (solver->checker);
+#endif
+	  dropped++;
+	  continue;
+	}
+      for (const unsigned *q = literals; q != next; q++)
+	PUSH (solver->clause, *q);
+      struct clause *c = new_redundant_clause (solver, glue);
+      LOGCLS (c, "reloaded");
+      c->used = 1;		// Survive at least one reduction.
+      CLEAR (solver->clause);
+      reloaded++;
+    }
+  munmap (begin, bytes);
+  rewind (spill->file);
+  if (ftruncate (fileno (spill->file), 0))
+    fatal_error ("failed to truncate spill file");
+  spill->bytes = 0;
+  ADD (reloaded, reloaded);
+  message (solver, 2, "[compact-%" PRIu64 "] "
+	   "reloaded %zu spilled clauses (dropped %zu)",
+	   solver->statistics.compactions, reloaded, dropped);
+}
+
+#endif
+
+// Redundant clauses with large enough glucose level (glue) which have not
+// been used since the last reduction are deletion candidates. If there
+// are new root-level fixed variables since the last reduction we also
+// mark clauses as garbage which are root-level satisfied too.
+
+static void
+gather_reduce_candidates (struct satch *solver, bool new_fixed_variables,
+			  struct candidates *candidates)
+{
+  size_t position = 0;
+  for (all_redundant_clauses (c))
+    {
+      position++;
+      assert (c->redundant);
+      if (c->garbage)
+	continue;
+      if (c->protected)
+	continue;
+      if (new_fixed_variables && clause_root_level_satisfied (solver, c))
+	{
+	  LOGCLS (c, "root-level satisfied thus marked garbage");
+	  c->garbage = true;
+	  continue;
+	}
+      const unsigned used = c->used;
+      if (used)
+	{
+	  c->used = used - 1;
+	  continue;
+	}
+      if (c->glue <= reduce_glue_limit)
+	{
+#ifndef NSPILL
+	  if (solver->options.spill_clauses && c->size > 2)
+	    spill_clause (solver, c);
+#endif
+	  continue;
+	}
+      const struct candidate candidate = {.clause = c,.position = position };
+      PUSH (*candidates, candidate);
+    }
+
+  if (solver->options.verbose < 2)
+    return;
+
+  const size_t size_candidates = SIZE (*candidates);
+  const size_t redundant = SIZE (solver->redundant);
+  message (solver, 2, "[reduced-%" PRIu64 "] "
+	   "gathered %zu reduce candidate clauses %.0f%%",
+	   solver->statistics.reductions,
+	   size_candidates, percent (size_candidates, redundant));
+}
+
 // Comparison function for 'qsort' to order reduce candidate clauses by
 // smaller glue first and then smaller size.  We are using 'qsort' which
 // is not stable and thus might produce different results for different
 // 'qsort' implementations.  To avoid this potential diverging behaviour
-// of different implementations of 'qsort' we have 'id's in clauses and
-// use those as deterministic tie breaker.
+// of different implementations of 'qsort' we use the position of clauses
+// on the 'redundant' stack as deterministic tie breaker, which orders
+// clauses by age (thus more recently learned clauses are kept).
 
 static int
 cmp_reduce_candidates (const void *p, const void *q)
 {
-  const struct clause *const c = *(struct clause * const *) p;
-  const struct clause *const d = *(struct clause * const *) q;
+  const struct candidate *const a = p, *const b = q;
+  const struct clause *const c = a->clause, *const d = b->clause;
   assert (c != d);
   if (c->glue < d->glue)
     return -1;
@@ -2625,91 +4526,1376 @@ cmp_reduce_candidates (const void *p, const void *q)
     return -1;
   if (c->size > d->size)
     return 1;
-  assert (c->id != d->id);
-  if (c->id < d->id)
+  assert (a->position != b->position);
+  if (a->position < b->position)
     return 1;
-  assert (c->id > d->id);
   return -1;
 }
 
-static void
-sort_reduce_candidates (struct satch *solver, struct clauses *candidates)
+static void
+sort_reduce_candidates (struct satch *solver, struct candidates *candidates)
+{
+  qsort (candidates->begin, SIZE (*candidates), sizeof (struct candidate),
+	 cmp_reduce_candidates);
+}
+
+static void
+mark_garbage_candidates (struct satch *solver, struct candidates *candidates)
+{
+  const size_t size = SIZE (*candidates);
+  const size_t target = (1 - reduce_fraction) * size;
+
+  while (SIZE (*candidates) > target)
+    {
+      struct clause *c = POP (*candidates).clause;
+      LOGCLS (c, "reducing thus marked garbage");
+      assert (!c->protected);
+      assert (!c->garbage);
+      c->garbage = true;
+    }
+}
+
+// Watches are appended in the order clauses are watched and thus long
+// clauses can be visited before binary clauses during propagation.  During
+// reduction we sort watch lists by clause size, which puts binary clauses
+// first, then ternary clauses and so on.  Thus conflicts and propagations
+// are more likely to be found early through cheap clauses, which in case
+// of a conflict also stops the traversal of the watch list early.  Note
+// that this happens before moving clauses (see below) such that clauses
+// are also placed in this order.
+
+static int
+cmp_watches (const void *p, const void *q)
+{
+  const struct watch *const a = p, *const b = q;
+#ifdef NBLOCK
+  const unsigned s = a->clause->size, t = b->clause->size;
+#else
+  const unsigned s = a->size, t = b->size;
+#endif
+  if (s < t)
+    return -1;
+  if (s > t)
+    return 1;
+#ifndef NBLOCK
+  if (a->blocking < b->blocking)
+    return -1;
+  if (a->blocking > b->blocking)
+    return 1;
+#endif
+  return 0;
+}
+
+static void
+sort_all_watches (struct satch *solver)
+{
+  struct watches *const all_watches = solver->watches;
+  for (all_literals (lit))
+    {
+      struct watches *const watches = all_watches + lit;
+      qsort (watches->begin, SIZE (*watches), sizeof (struct watch),
+	     cmp_watches);
+    }
+}
+
+// After deleting garbage clauses all remaining clauses are moved to a new
+// arena block and the old blocks are freed.  With 'reorder_clauses' the
+// clauses are placed in the order in which they are first found in reasons
+// on the trail and then in watch lists, such that clauses which are visited
+// together during propagation end up in the same cache lines and pages.
+// Otherwise they are simply moved in the order of the clause stacks.
+// A moved clause gets size zero and the new address is stored in its
+// first two literals as forwarding pointer.
+
+static struct clause *
+move_clause (struct satch *solver, struct clause *c)
+{
+  struct clause *res;
+  assert (sizeof res <= 2 * sizeof (unsigned));
+  if (!c->size)
+    memcpy (&res, c->literals, sizeof res);
+  else
+    {
+      const size_t bytes = bytes_of_clause (c);
+      res = allocate_in_arena (solver, bytes);
+      memcpy (res, c, bytes);
+      c->size = 0;
+      memcpy (c->literals, &res, sizeof res);
+    }
+  return res;
+}
+
+static void
+move_reasons (struct satch *solver)
+{
+  struct clause **const reasons = solver->reasons;
+  for (all_elements_on_stack (unsigned, lit, solver->trail))
+    {
+      const unsigned idx = INDEX (lit);
+      struct clause *const reason = reasons[idx];
+      if (reason)
+	reasons[idx] = move_clause (solver, reason);
+    }
+}
+
+static void
+move_watches (struct satch *solver)
+{
+  struct watches *const all_watches = solver->watches;
+  for (all_literals (lit))
+    {
+      struct watches *const watches = all_watches + lit;
+      for (struct watch * p = watches->begin; p != watches->end; p++)
+	p->clause = move_clause (solver, p->clause);
+    }
+}
+
+static void
+move_stack (struct satch *solver, struct clauses *clauses)
+{
+  for (struct clause ** p = clauses->begin; p != clauses->end; p++)
+    *p = move_clause (solver, *p);
+}
+
+static size_t
+move_clauses (struct satch *solver)
+{
+  size_t bytes = 0;
+  for (all_irredundant_clauses (c))
+    bytes += arena_bytes (bytes_of_clause (c));
+  for (all_redundant_clauses (c))
+    bytes += arena_bytes (bytes_of_clause (c));
+
+  struct blocks old_blocks = solver->arena.blocks;
+  INIT (solver->arena.blocks);
+  new_arena_block (solver, bytes);
+
+  // Each of the three pointer sources is traversed exactly once, such that
+  // all pointers are old before, and new after, their traversal.
+  //
+  if (solver->options.reorder_clauses)
+    {
+      move_reasons (solver);
+      move_watches (solver);
+      move_stack (solver, &solver->irredundant);
+      move_stack (solver, &solver->redundant);
+    }
+  else
+    {
+      move_stack (solver, &solver->irredundant);
+      move_stack (solver, &solver->redundant);
+      move_watches (solver);
+      move_reasons (solver);
+    }
+
+  release_arena_blocks (&old_blocks);
+  return bytes;
+}
+
+static void
+reduce (struct satch *solver)
+{
+  const uint64_t reductions = INC (reductions);
+
+  assert (solver->statistics.redundant == SIZE (solver->redundant));
+  assert (solver->statistics.irredundant == SIZE (solver->irredundant));
+
+  set_protect_flag_of_reasons (solver, true);
+
+  const bool new_fixed_variables =
+    solver->limits.reduce.fixed < solver->statistics.fixed;
+  if (new_fixed_variables)
+    mark_satisfied_irredundant_clauses_as_garbage (solver);
+
+  struct candidates candidates;
+  INIT (candidates);
+  gather_reduce_candidates (solver, new_fixed_variables, &candidates);
+  sort_reduce_candidates (solver, &candidates);
+  mark_garbage_candidates (solver, &candidates);
+  RELEASE (candidates);
+
+  flush_garbage_watches (solver);
+  if (solver->options.sort_watches)
+    sort_all_watches (solver);
+
+  size_t bytes = 0, count = 0;
+  if (new_fixed_variables)
+    delete_garbage_clauses (solver, &solver->irredundant, &bytes, &count);
+  delete_garbage_clauses (solver, &solver->redundant, &bytes, &count);
+  const size_t moved = move_clauses (solver);
+
+  set_protect_flag_of_reasons (solver, false);
+
+  solver->limits.reduce.fixed = solver->statistics.fixed;
+
+  const uint64_t interval = reduce_interval * ndivlogn (reductions);
+  solver->limits.reduce.conflicts = CONFLICTS + interval;
+
+  LOG ("next reduce limit at %" PRIu64 " conflicts after %" PRIu64,
+       solver->limits.reduce.conflicts, interval);
+
+  message (solver, 2, "[reduced-%" PRIu64 "] "
+	   "collected %zu clauses (%zu bytes, %.0f MB)",
+	   reductions, count, bytes, bytes / (double) (1 << 20));
+  message (solver, 3, "[reduced-%" PRIu64 "] "
+	   "moved %zu bytes (%.0f MB) of remaining clauses",
+	   reductions, moved, moved / (double) (1 << 20));
+
+  report (solver, '-');
+}
+
+#endif
+
+/*------------------------------------------------------------------------*/
+
+// Blocked clause elimination removes irredundant clauses 'C' which contain
+// a literal 'lit' such that all resolvents of 'C' on 'lit' with clauses
+// containing 'NOT (lit)' are tautological.  Covered clause elimination
+// extends 'C' first by 'covered' literals, which occur in all
+// non-tautological resolution candidates on one of the literals of the
+// clause (covered literal addition), and then checks whether the extended
+// clause is blocked.  Eliminated clauses are saved on the 'extension'
+// stack in order to reconstruct a satisfying assignment of the original
+// formula in 'extend_witness'.  Both techniques need occurrence lists,
+// which are connected only during elimination.
+
+#ifndef NBLOCKED
+
+// Connect all non-garbage irredundant clauses to occurrence lists.
+
+static void
+init_occurrences (struct satch *solver)
+{
+  assert (!solver->occurrences);
+  solver->occurrences = calloc (LITERALS, sizeof (struct clauses));
+  if (!solver->occurrences)
+    out_of_memory (LITERALS * sizeof (struct clauses));
+  for (all_irredundant_clauses (c))
+    if (!c->garbage)
+      for (all_literals_in_clause (lit, c))
+	PUSH (solver->occurrences[lit], c);
+}
+
+static void
+release_occurrences (struct satch *solver)
+{
+  struct clauses *occurrences = solver->occurrences;
+  for (all_literals (lit))
+    RELEASE (occurrences[lit]);
+  free (occurrences);
+  solver->occurrences = 0;
+}
+
+// Entries on the extension stack are started by an 'INVALID' separator,
+// followed by the witness literal and then the rest of the literals.
+
+static void
+push_extension (struct satch *solver, unsigned witness,
+		const unsigned *begin, const unsigned *end)
+{
+  PUSH (solver->extension, INVALID);
+  PUSH (solver->extension, witness);
+  for (const unsigned *p = begin; p != end; p++)
+    if (*p != witness)
+      PUSH (solver->extension, *p);
+}
+
+// Go over the extension stack in reverse order and flip the value of the
+// witness literal of every falsified clause.
+
+static void
+extend_witness (struct satch *solver)
+{
+  LOG ("extending witness with %zu extension stack entries",
+       SIZE (solver->extension));
+  signed char *const values = solver->values;
+  const unsigned *const begin = solver->extension.begin;
+  const unsigned *end = solver->extension.end;
+  while (end != begin)
+    {
+      const unsigned *p = end;
+      bool satisfied = false;
+      unsigned lit;
+      while (assert (p != begin), (lit = *--p) != INVALID)
+	if (literal_value (values, lit) > 0)
+	  satisfied = true;
+      if (!satisfied)
+	{
+	  const unsigned witness = p[1];
+	  LOG ("flipping witness literal %u", witness);
+	  assert (literal_value (values, witness) < 0);
+	  reset_value (values, witness);
+	  set_value (values, witness);
+	}
+      end = p;
+    }
+
+  // Flipped literals are flipped on the trail too, which keeps the trail
+  // consistent with the values for backtracking later.
+  //
+  const unsigned *const end_trail = solver->trail.end;
+  for (unsigned *p = solver->trail.begin; p != end_trail; p++)
+    if (literal_value (values, *p) < 0)
+      *p = NOT (*p);
+}
+
+// Try to eliminate the clause 'c' as blocked or covered clause.  The
+// temporary 'clause' is extended by covered literals and each covered
+// literal addition step is pushed on the extension stack (followed by the
+// final blocked clause), since reconstruction has to undo them in reverse.
+
+static bool
+eliminate_covered_clause (struct satch *solver, struct clause *c,
+			  struct unsigned_stack *covered, uint64_t *ticks)
+{
+  assert (EMPTY (solver->clause));
+  const signed char *const values = solver->values;
+  for (all_literals_in_clause (lit, c))
+    {
+      const signed char value = literal_value (values, lit);
+      assert (value <= 0);
+      if (value < 0)
+	continue;
+      PUSH (solver->clause, lit);
+      mark_literal (solver, lit);
+    }
+
+  const size_t saved = SIZE (solver->extension);
+  struct clauses *const occurrences = solver->occurrences;
+  bool eliminated = false, extended = false;
+
+  for (size_t i = 0; !eliminated && i < SIZE (solver->clause); i++)
+    {
+      const unsigned lit = ACCESS (solver->clause, i);
+      const unsigned not_lit = NOT (lit);
+      struct clauses *const candidates = occurrences + not_lit;
+      if (SIZE (*candidates) > blocked_occurrences)
+	continue;
+      CLEAR (*covered);
+      bool blocked = true, first = true;
+      for (all_pointers_on_stack (struct clause, d, *candidates))
+	{
+	  if (d->garbage)
+	    continue;
+	  *ticks += 1;
+	  bool tautological = false;
+	  for (all_literals_in_clause (other, d))
+	    if (other != not_lit && marked_literal (solver, other) < 0)
+	      {
+		tautological = true;
+		break;
+	      }
+	  if (tautological)
+	    continue;
+	  blocked = false;
+	  if (first)
+	    {
+	      for (all_literals_in_clause (other, d))
+		if (other != not_lit && !literal_value (values, other) &&
+		    !marked_literal (solver, other))
+		  PUSH (*covered, other);
+	      first = false;
+	    }
+	  else
+	    {
+	      unsigned *q = covered->begin;
+	      for (all_elements_on_stack (unsigned, other, *covered))
+		{
+		  bool found = false;
+		  for (all_literals_in_clause (tmp, d))
+		    if (tmp == other)
+		      {
+			found = true;
+			break;
+		      }
+		  if (found)
+		    *q++ = other;
+		}
+	      covered->end = q;
+	      *ticks += d->size;
+	    }
+	  if (EMPTY (*covered))
+	    break;
+	}
+      if (blocked)
+	{
+	  LOG ("clause blocked on literal %u", lit);
+	  push_extension (solver, lit,
+			  solver->clause.begin, solver->clause.end);
+	  eliminated = true;
+	}
+      else if (!EMPTY (*covered))
+	{
+	  LOG ("adding %zu covered literals on %u", SIZE (*covered), lit);
+	  push_extension (solver, lit,
+			  solver->clause.begin, solver->clause.end);
+	  for (all_elements_on_stack (unsigned, other, *covered))
+	    {
+	      assert (!marked_literal (solver, other));
+	      PUSH (solver->clause, other);
+	      mark_literal (solver, other);
+	    }
+	  extended = true;
+	}
+    }
+
+  for (all_elements_on_stack (unsigned, lit, solver->clause))
+    unmark_literal (solver, lit);
+  CLEAR (solver->clause);
+
+  if (!eliminated)
+    {
+      solver->extension.end = solver->extension.begin + saved;
+      return false;
+    }
+
+  if (extended)
+    {
+      LOGCLS (c, "covered thus marked garbage");
+      INC (covered);
+    }
+  else
+    {
+      LOGCLS (c, "blocked thus marked garbage");
+      INC (blocked);
+    }
+  c->garbage = true;
+  return true;
+}
+
+// Eliminate blocked and covered irredundant clauses at the root-level.
+// The scheduler in 'simplify' limits the effort in terms of 'ticks' and the
+// next round resumes where this one stopped.
+
+static void
+eliminate_blocked_clauses (struct satch *solver, uint64_t effort)
+{
+  assert (!solver->level);
+  assert (solver->statistics.irredundant == SIZE (solver->irredundant));
+  for (all_irredundant_clauses (c))
+    if (clause_root_level_satisfied (solver, c))
+      {
+	LOGCLS (c, "root-level satisfied thus marked garbage");
+	c->garbage = true;
+      }
+  init_occurrences (solver);
+
+  const uint64_t blocked_before = solver->statistics.blocked;
+  const uint64_t covered_before = solver->statistics.covered;
+
+  struct unsigned_stack covered;
+  INIT (covered);
+
+  const size_t size = SIZE (solver->irredundant);
+  size_t position = solver->limits.blocked.position;
+  if (position >= size)
+    position = 0;
+
+  uint64_t ticks = 0;
+  size_t tried = 0;
+  while (tried < size && ticks < effort)
+    {
+      struct clause *c = ACCESS (solver->irredundant, position);
+      if (!c->garbage)
+	(void) eliminate_covered_clause (solver, c, &covered, &ticks);
+      if (++position == size)
+	position = 0;
+      tried++;
+    }
+
+  RELEASE (covered);
+  release_occurrences (solver);
+
+  const uint64_t blocked = solver->statistics.blocked - blocked_before;
+  const uint64_t covered_clauses =
+    solver->statistics.covered - covered_before;
+
+  // The resume position has to be adjusted for deleted clauses before it.
+  //
+  for (size_t i = 0, end = position; i < end; i++)
+    if (ACCESS (solver->irredundant, i)->garbage)
+      position--;
+  solver->limits.blocked.position = position;
+
+  flush_garbage_watches (solver);
+  size_t bytes = 0, count = 0;
+  delete_garbage_clauses (solver, &solver->irredundant, &bytes, &count);
+#ifndef NSUBSUME
+  delete_garbage_clauses (solver, &solver->redundant, &bytes, &count);
+#endif
+
+  message (solver, 2, "[eliminated-%" PRIu64 "] "
+	   "%" PRIu64 " blocked and %" PRIu64 " covered clauses "
+	   "in %zu tried (%" PRIu64 " ticks)",
+	   solver->statistics.eliminations, blocked, covered_clauses,
+	   tried, ticks);
+}
+
+#endif
+
+/*------------------------------------------------------------------------*/
+
+// Binary clauses are propagated without accessing the clause (at least if
+// blocking literals are enabled) but still each of them occupies a watch in
+// the watch lists of both of its literals.  Learned binary clauses often
+// are duplicates of existing ones or are implied transitively by other
+// binary clauses through the binary implication graph.  This section
+// removes duplicated binary clauses and performs transitive reduction at
+// the root-level, which in both cases shortens the watch lists traversed
+// in 'propagate_literal'.  As a side effect we find units through hyper
+// unary resolution and failed literals.
+
+#ifndef NTRANSITIVE
+
+// Return the other literal if the watch is a binary clause watch of 'lit'
+// and 'INVALID' otherwise.
+
+static inline unsigned
+other_binary_literal (struct watch watch, unsigned lit)
+{
+#ifndef NBLOCK
+  if (watch.size != 2)
+    return INVALID;
+  (void) lit;
+  return watch.blocking;
+#else
+  const struct clause *const c = watch.clause;
+  if (c->size != 2)
+    return INVALID;
+  return c->literals[0] ^ c->literals[1] ^ lit;
+#endif
+}
+
+// Learn a unit clause found during transitive reduction.
+
+static void
+transitive_unit (struct satch *solver, unsigned unit)
+{
+  const signed char value = literal_value (solver->values, unit);
+  if (value > 0)
+    return;
+  assert (!value);
+  LOG ("transitive reduction found unit %u", unit);
+  INC (transitive_units);
+  assign (solver, unit, 0);
+  solver->iterate = true;
+#ifndef NDEBUG
+  checker_add (solver->checker, export_literal (solver, unit));
+  checker_learned (solver->checker);
+#endif
+}
+
+// Mark duplicated binary clauses as garbage, where irredundant clauses
+// are kept in favor of redundant ones.  If both 'lit | other' and 'lit |
+// NOT (other)' occur then 'lit' is a unit (hyper unary resolution).
+
+static void
+remove_duplicated_binary_clauses (struct satch *solver, uint64_t *ticks)
+{
+  const signed char *const values = solver->values;
+  for (all_literals (lit))
+    {
+      if (literal_value (values, lit))
+	continue;
+      struct watches *const watches = solver->watches + lit;
+      *ticks += 1 + SIZE (*watches) / (128 / sizeof (struct watch));
+      unsigned unit = INVALID;
+      for (int redundant = 0; unit == INVALID && redundant < 2; redundant++)
+	for (all_elements_on_stack (struct watch, watch, *watches))
+	  {
+	    const unsigned other = other_binary_literal (watch, lit);
+	    if (other == INVALID || literal_value (values, other))
+	      continue;
+	    struct clause *const c = watch.clause;
+	    if (c->garbage || c->redundant != redundant)
+	      continue;
+	    const signed char mark = marked_literal (solver, other);
+	    if (mark > 0)
+	      {
+		LOGCLS (c, "duplicated binary thus marked garbage");
+		INC (duplicated);
+		c->garbage = true;
+	      }
+	    else if (mark < 0)
+	      {
+		LOG ("hyper unary resolution on %u yields unit %u", other, lit);
+		unit = lit;
+		break;
+	      }
+	    else
+	      {
+		mark_literal (solver, other);
+		PUSH (solver->clause, other);
+	      }
+	  }
+      for (all_elements_on_stack (unsigned, other, solver->clause))
+	unmark_literal (solver, other);
+      CLEAR (solver->clause);
+      if (unit != INVALID)
+	transitive_unit (solver, unit);
+    }
+}
+
+// Search for a path from 'NOT (lit)' to 'other' in the binary implication
+// graph ignoring the binary clause 'c' itself.  Irredundant clauses are
+// only allowed to be removed if the path consists of irredundant clauses.
+// If we reach 'lit' then 'NOT (lit)' is a failed literal and 'lit' a unit.
+// The search gives up (no path found) as soon as 'effort' ticks are spent.
+
+static bool
+transitive_path (struct satch *solver, struct clause *c,
+		 unsigned lit, unsigned other, uint64_t * ticks,
+		 uint64_t effort, unsigned *unit_ptr)
+{
+  assert (EMPTY (solver->clause));
+  const signed char *const values = solver->values;
+  const bool irredundant = !c->redundant;
+  const unsigned src = NOT (lit);
+  mark_literal (solver, src);
+  PUSH (solver->clause, src);
+  bool found = false;
+  for (size_t next = 0; !found && next < SIZE (solver->clause); next++)
+    {
+      if (*ticks > effort)
+	break;
+      const unsigned implying = ACCESS (solver->clause, next);
+      const unsigned not_implying = NOT (implying);
+      struct watches *const watches = solver->watches + not_implying;
+      *ticks += 1 + SIZE (*watches) / (128 / sizeof (struct watch));
+      for (all_elements_on_stack (struct watch, watch, *watches))
+	{
+	  const unsigned implied = other_binary_literal (watch, not_implying);
+	  if (implied == INVALID || literal_value (values, implied))
+	    continue;
+	  struct clause *const d = watch.clause;
+	  if (d == c || d->garbage)
+	    continue;
+	  if (irredundant && d->redundant)
+	    continue;
+	  const signed char mark = marked_literal (solver, implied);
+	  if (mark > 0)
+	    continue;
+	  if (mark < 0)
+	    {
+	      LOG ("failed literal %u implies %u and %u",
+		   src, implied, NOT (implied));
+	      *unit_ptr = lit;
+	      found = true;
+	      break;
+	    }
+	  if (implied == other)
+	    {
+	      found = true;
+	      break;
+	    }
+	  mark_literal (solver, implied);
+	  PUSH (solver->clause, implied);
+	}
+    }
+  for (all_elements_on_stack (unsigned, implied, solver->clause))
+    unmark_literal (solver, implied);
+  CLEAR (solver->clause);
+  return found;
+}
+
+static void
+transitive_reduction (struct satch *solver, uint64_t effort)
+{
+  assert (!solver->level);
+
+  const uint64_t duplicated_before = solver->statistics.duplicated;
+  const uint64_t reduced_before = solver->statistics.transitive_reduced;
+  const uint64_t units_before = solver->statistics.transitive_units;
+
+  uint64_t ticks = 0;
+  remove_duplicated_binary_clauses (solver, &ticks);
+
+  // Each binary clause is checked once from its smaller literal, which is
+  // enough since the binary implication graph is skew-symmetric.
+  //
+  const signed char *const values = solver->values;
+  const unsigned literals = LITERALS;
+  unsigned lit = solver->limits.transitive.literal;
+  if (lit >= literals)
+    lit = 0;
+  for (unsigned tried = 0; tried < literals && ticks < effort; tried++)
+    {
+      if (!literal_value (values, lit))
+	{
+	  struct watches *const watches = solver->watches + lit;
+	  for (all_elements_on_stack (struct watch, watch, *watches))
+	    {
+	      if (ticks > effort)
+		break;
+	      const unsigned other = other_binary_literal (watch, lit);
+	      if (other == INVALID || other < lit ||
+		  literal_value (values, other))
+		continue;
+	      struct clause *const c = watch.clause;
+	      if (c->garbage)
+		continue;
+	      unsigned unit = INVALID;
+	      if (!transitive_path (solver, c, lit, other,
+				    &ticks, effort, &unit))
+		continue;
+	      if (unit != INVALID)
+		{
+		  transitive_unit (solver, unit);
+		  break;
+		}
+	      LOGCLS (c, "transitive thus marked garbage");
+	      INC (transitive_reduced);
+	      c->garbage = true;
+	    }
+	}
+      if (++lit == literals)
+	lit = 0;
+    }
+  solver->limits.transitive.literal = lit;
+
+  flush_garbage_watches (solver);
+  size_t bytes = 0, count = 0;
+  delete_garbage_clauses (solver, &solver->irredundant, &bytes, &count);
+#ifndef NLEARN
+  delete_garbage_clauses (solver, &solver->redundant, &bytes, &count);
+#endif
+
+  message (solver, 2, "[transitive-%" PRIu64 "] "
+	   "removed %" PRIu64 " duplicated and %" PRIu64 " transitive "
+	   "binary clauses and found %" PRIu64 " units (%" PRIu64 " ticks)",
+	   solver->statistics.transitive_reductions,
+	   solver->statistics.duplicated - duplicated_before,
+	   solver->statistics.transitive_reduced - reduced_before,
+	   solver->statistics.transitive_units - units_before, ticks);
+}
+
+#endif
+
+/*------------------------------------------------------------------------*/
+
+// Root-level fixed variables still occupy space in all variable and literal
+// indexed arrays and variables which occur together in clauses are spread
+// over these arrays in the order in which they were imported.  Compacting
+// maps all fixed variables to one remaining fixed variable (with the sign
+// of their value) and renumbers the other variables in the order of their
+// first occurrence in clauses, which puts variables occurring together
+// next to each other and thus improves cache locality during propagation
+// and analysis.  The external view is kept unchanged through the 'imports'
+// and 'exported' maps, i.e., 'satch_val' and proof checking work as before.
+
+#ifndef NCOMPACT
+
+// Remove root-level satisfied clauses and root-level falsified literals.
+// Afterwards only variables in the extension stack can still be fixed.
+
+static void
+flush_root_level_assigned_literals (struct satch *solver,
+				    struct clauses *clauses)
+{
+  const signed char *const values = solver->values;
+  for (all_pointers_on_stack (struct clause, c, *clauses))
+    {
+      if (c->garbage)
+	continue;
+      bool satisfied = false;
+      unsigned falsified = 0;
+      for (all_literals_in_clause (lit, c))
+	{
+	  const signed char value = literal_value (values, lit);
+	  if (value > 0)
+	    {
+	      satisfied = true;
+	      break;
+	    }
+	  if (value < 0)
+	    falsified++;
+	}
+      if (satisfied)
+	{
+	  LOGCLS (c, "root-level satisfied thus marked garbage");
+	  c->garbage = true;
+	  continue;
+	}
+      if (!falsified)
+	continue;
+      LOGCLS (c, "removing %u root-level falsified literals from",
+	      falsified);
+#ifndef NDEBUG
+      for (all_literals_in_clause (lit, c))
+	if (!literal_value (values, lit))
+	  checker_add (solver->checker, export_literal (solver, lit));
+      checker_learned (solver->checker);
+      for (all_literals_in_clause (lit, c))
+	checker_add (solver->checker, export_literal (solver, lit));
+      checker_remove (solver->checker);
+#endif
+#ifdef COMPRESS
+      if (c->compressed)
+	{
+	  decode_literals (solver, c);
+	  unsigned *const literals = solver->decoded.begin;
+	  unsigned *q = literals;
+	  for (all_elements_on_stack (unsigned, lit, solver->decoded))
+	    if (!literal_value (values, lit))
+	      *q++ = lit;
+	  set_compressed_literals (c, literals, q - literals);
+	}
+      else
+#endif
+	{
+	  unsigned *q = c->literals;
+	  for (all_literals_in_clause (lit, c))
+	    if (!literal_value (values, lit))
+	      *q++ = lit;
+	  c->size = q - c->literals;
+	}
+      assert (c->size > 1);
+      if (c->glue > c->size)
+	c->glue = c->size;
+    }
+}
+
+// The 'map' maps old variable indices to new literals (of the positive
+// old literal) and 'reverse' new variable indices back to the old ones.
+
+static inline void
+renumber_variable (unsigned *map, unsigned *reverse,
+		   unsigned *new_size_ptr, unsigned idx)
+{
+  if (map[idx] != INVALID)
+    return;
+  const unsigned new_idx = (*new_size_ptr)++;
+  reverse[new_idx] = idx;
+  map[idx] = LITERAL (new_idx);
+}
+
+static inline unsigned
+map_literal (const unsigned *map, unsigned lit)
+{
+  const unsigned res = map[INDEX (lit)];
+  return SIGN (lit) ? NOT (res) : res;
+}
+
+#ifdef COMPRESS
+
+// Renumbered literals of compressed clauses might need more bytes than
+// reserved, in which case the clause is moved to a new arena location.
+// This is fine since all clauses are watched again after compaction and
+// root-level assigned literals do not have reasons.  The order of the
+// literals does not matter for the same reason.
+
+static struct clause *
+map_compressed_clause (struct satch *solver, const unsigned *map,
+		       struct clause *c)
+{
+  decode_literals (solver, c);
+  unsigned *const literals = solver->decoded.begin;
+  const unsigned size = c->size;
+  for (unsigned i = 0; i < size; i++)
+    literals[i] = map_literal (map, literals[i]);
+  qsort (literals, size, sizeof (unsigned), cmp_literals);
+  const size_t reserved = bytes_sorted (literals, literals + size);
+  if (reserved > *reserved_tail (c))
+    {
+      struct clause *const d =
+	allocate_in_arena (solver, bytes_compressed (reserved));
+      memcpy (d, c, sizeof *c);
+      *reserved_tail (d) = reserved;
+      c = d;
+    }
+  set_compressed_literals (c, literals, size);
+  return c;
+}
+
+#endif
+
+static inline void
+map_clauses (struct satch *solver, const unsigned *map,
+	     struct clauses *clauses)
+{
+  for (struct clause ** q = clauses->begin; q != clauses->end; q++)
+    {
+      struct clause *const c = *q;
+#ifdef COMPRESS
+      if (c->compressed)
+	{
+	  *q = map_compressed_clause (solver, map, c);
+	  continue;
+	}
+#else
+      (void) solver;
+#endif
+      for (unsigned *p = c->literals, *end = p + c->size; p != end; p++)
+	*p = map_literal (map, *p);
+    }
+}
+
+// Similar to 'RESIZE' but copies the data of old variable 'reverse[idx]'
+// to new variable 'idx' for variable ('FACTOR==1') or literal indexed
+// arrays ('FACTOR==2').  Data beyond the new size is cleared, as expected
+// by 'increase_size' if more variables are imported later.  The permuted
+// data is copied back since the array might be reserved memory.
+
+#define REMAP(FACTOR,NAME) \
+do { \
+  const size_t size = FACTOR * sizeof *solver->NAME; \
+  const size_t bytes = solver->capacity * size; \
+  char * chunk = calloc (bytes, 1); \
+  if (!chunk) \
+    out_of_memory (bytes); \
+  const char * const old = (const char *) solver->NAME; \
+  for (unsigned idx = 0; idx < new_size; idx++) \
+    memcpy (chunk + idx * size, old + reverse[idx] * size, size); \
+  memcpy (solver->NAME, chunk, bytes); \
+  free (chunk); \
+} while (0)
+
+#ifdef PACKED
+
+// Packed values can not be copied byte-wise and are remapped explicitly.
+
+static void
+remap_packed_values (struct satch *solver, unsigned new_size,
+		     const unsigned *reverse)
+{
+  const size_t bytes = bytes_values (solver->capacity);
+  signed char *chunk = calloc (bytes, 1);
+  if (!chunk)
+    out_of_memory (bytes);
+  const signed char *const old = solver->values;
+  for (unsigned idx = 0; idx < new_size; idx++)
+    {
+      const unsigned lit = LITERAL (idx);
+      const signed char value = literal_value (old, LITERAL (reverse[idx]));
+      if (value > 0)
+	set_value (chunk, lit);
+      else if (value < 0)
+	set_value (chunk, NOT (lit));
+    }
+  memcpy (solver->values, chunk, bytes);
+  free (chunk);
+}
+
+#endif
+
+static void
+compact_variables (struct satch *solver, uint64_t effort)
+{
+  (void) effort;
+  assert (!solver->level);
+  assert (solver->trail.propagate == solver->trail.end);
+
+  // Variables are ordered at the first compaction but afterwards we only
+  // compact again if new variables have been fixed.
+  //
+  const uint64_t compactions = solver->statistics.compactions;
+  if (compactions > 1 &&
+      solver->limits.compact.fixed == solver->statistics.fixed)
+    {
+      message (solver, 2, "[compact-%" PRIu64 "] "
+	       "skipped as no new variables were fixed", compactions);
+      return;
+    }
+  solver->limits.compact.fixed = solver->statistics.fixed;
+
+#ifndef NSPILL
+  reload_spilled_clauses (solver);
+#endif
+  flush_root_level_assigned_literals (solver, &solver->irredundant);
+#ifndef NLEARN
+  flush_root_level_assigned_literals (solver, &solver->redundant);
+#endif
+
+  // All clauses are watched again after renumbering anyhow.
+  //
+  for (all_literals (lit))
+    CLEAR (solver->watches[lit]);
+  size_t bytes = 0, count = 0;
+  delete_garbage_clauses (solver, &solver->irredundant, &bytes, &count);
+#ifndef NLEARN
+  delete_garbage_clauses (solver, &solver->redundant, &bytes, &count);
+#endif
+
+  const unsigned old_size = VARIABLES;
+  const size_t map_bytes = old_size * sizeof (unsigned);
+  unsigned *const map = malloc (map_bytes);
+  unsigned *const reverse = malloc (map_bytes);
+  if (!map || !reverse)
+    out_of_memory (map_bytes);
+  for (all_variables (idx))
+    map[idx] = INVALID;
+
+  unsigned new_size = 0;
+  for (all_irredundant_clauses (c))
+    for (all_literals_in_clause (lit, c))
+	renumber_variable (map, reverse, &new_size, INDEX (lit));
+#ifndef NLEARN
+  for (all_redundant_clauses (c))
+    for (all_literals_in_clause (lit, c))
+	renumber_variable (map, reverse, &new_size, INDEX (lit));
+#endif
+#ifndef NBLOCKED
+  for (all_elements_on_stack (unsigned, lit, solver->extension))
+    if (lit != INVALID)
+      renumber_variable (map, reverse, &new_size, INDEX (lit));
+#endif
+
+  // Unassigned variables without occurrences are kept in queue order.
+  //
+  const signed char *const values = solver->values;
+  {
+    const struct link *const links = solver->links;
+    for (unsigned idx = solver->queue.first; idx != INVALID;
+	 idx = links[idx].next)
+      if (!literal_value (values, LITERAL (idx)))
+	renumber_variable (map, reverse, &new_size, idx);
+  }
+
+  // The first remaining fixed variable represents all the others.
+  //
+  unsigned representative = INVALID, removed = 0;
+  for (all_elements_on_stack (unsigned, lit, solver->trail))
+    {
+      const unsigned idx = INDEX (lit);
+      if (map[idx] != INVALID)
+	continue;
+      if (representative == INVALID)
+	{
+	  representative = idx;
+	  renumber_variable (map, reverse, &new_size, idx);
+	  continue;
+	}
+      const unsigned other = LITERAL (representative);
+      const unsigned mapped = map[representative];
+      const signed char value = literal_value (values, LITERAL (idx));
+      map[idx] = value == literal_value (values, other) ? mapped
+	: NOT (mapped);
+      LOG ("mapping fixed literal %u to %u", LITERAL (idx), map[idx]);
+      removed++;
+    }
+  assert (new_size + removed == old_size);
+
+  map_clauses (solver, map, &solver->irredundant);
+#ifndef NLEARN
+  map_clauses (solver, map, &solver->redundant);
+#endif
+#ifndef NBLOCKED
+  for (unsigned *p = solver->extension.begin; p != solver->extension.end;
+       p++)
+    if (*p != INVALID)
+      *p = map_literal (map, *p);
+#endif
+  for (struct import * p = solver->imports.begin;
+       p != solver->imports.end; p++)
+    p->internal = map_literal (map, p->internal);
+
+  // Removed fixed literals are removed from the trail too.
+  //
+  {
+    struct trail *const trail = &solver->trail;
+    unsigned *q = trail->begin;
+    for (const unsigned *p = q; p != trail->end; p++)
+      {
+	const unsigned lit = *p;
+	const unsigned mapped = map_literal (map, lit);
+	if (reverse[INDEX (mapped)] == INDEX (lit))
+	  *q++ = mapped;
+      }
+    trail->end = trail->propagate = q;
+  }
+
+  REMAP (1, exported);
+  REMAP (1, levels);
+  REMAP (1, reasons);
+#ifdef PACKED
+  remap_packed_values (solver, new_size, reverse);
+#else
+  REMAP (2, values);
+#endif
+  REMAP (1, saved);
+#ifndef NMODE
+  REMAP (1, targets);
+#endif
+
+  // The decision queue is rebuilt in the same order with new stamps.
+  //
+  {
+    const size_t bytes = solver->capacity * sizeof *solver->links;
+    struct link *const old_links = malloc (bytes);
+    if (!old_links)
+      out_of_memory (bytes);
+    memcpy (old_links, solver->links, bytes);
+    memset (solver->links, 0, bytes);
+    struct queue *const queue = &solver->queue;
+    const unsigned first = queue->first;
+    queue->first = queue->last = queue->search = INVALID;
+    queue->stamp = 0;
+    for (unsigned idx = first; idx != INVALID; idx = old_links[idx].next)
+      {
+	const unsigned mapped = INDEX (map[idx]);
+	if (reverse[mapped] == idx)
+	  enqueue (solver, mapped);
+      }
+    free (old_links);
+  }
+
+  for (unsigned lit = 2 * new_size; lit < 2 * old_size; lit++)
+    RELEASE (solver->watches[lit]);
+
+  solver->size = new_size;
+  assert (solver->unassigned == new_size - SIZE (solver->trail));
+
+  for (all_irredundant_clauses (c))
+    watch_clause (solver, c);
+#ifndef NLEARN
+  for (all_redundant_clauses (c))
+    watch_clause (solver, c);
+#endif
+
+#ifndef NBLOCKED
+  solver->limits.blocked.position = 0;
+#endif
+#ifndef NTRANSITIVE
+  solver->limits.transitive.literal = 0;
+#endif
+  ADD (compacted, removed);
+
+  free (reverse);
+  free (map);
+
+  message (solver, 2, "[compact-%" PRIu64 "] "
+	   "removed %u fixed variables and renumbered %u variables",
+	   compactions, removed, new_size);
+}
+
+#endif
+
+/*------------------------------------------------------------------------*/
+
+// Inprocessing scheduler.  Simplification passes are listed as 'SIMPLIFIER'
+// items in 'SIMPLIFIERS' (with the same idiom as 'PROFILES' and 'REPORTS')
+// giving their name, the statistics counter of their rounds, the function
+// implementing the pass and the report type.  The name is used for the
+// profile, the limits and the hard coded options 'NAME_interval',
+// 'NAME_effort' and 'NAME_min_effort'.  A pass is triggered after a number
+// of conflicts, which grows with 'ndivlogn' in the number of rounds, and
+// its effort is a fraction of the search ticks since its last round.  Thus
+// adding another pass only requires to add it to this list and provide
+// those options, limits, counter and profile, while its overhead remains
+// bounded relative to search time.
+
+#ifndef NSIMPLIFY
+
+#define SIMPLIFIERS \
+SIMPLIFIER_IF_BLOCKED (blocked, eliminations, \
+                       eliminate_blocked_clauses, 'b') \
+SIMPLIFIER_IF_TRANSITIVE (transitive, transitive_reductions, \
+                          transitive_reduction, 't') \
+SIMPLIFIER_IF_COMPACT (compact, compactions, compact_variables, 'c')
+
+#define DO_NOT_SIMPLIFY(NAME,COUNT,PASS,TYPE) /**/
+#ifdef NBLOCKED
+#define SIMPLIFIER_IF_BLOCKED DO_NOT_SIMPLIFY
+#else
+#define SIMPLIFIER_IF_BLOCKED SIMPLIFIER
+#endif
+#ifdef NTRANSITIVE
+#define SIMPLIFIER_IF_TRANSITIVE DO_NOT_SIMPLIFY
+#else
+#define SIMPLIFIER_IF_TRANSITIVE SIMPLIFIER
+#endif
+#ifdef NCOMPACT
+#define SIMPLIFIER_IF_COMPACT DO_NOT_SIMPLIFY
+#else
+#define SIMPLIFIER_IF_COMPACT SIMPLIFIER
+#endif
+
+static bool
+simplifying (struct satch *solver)
 {
-  qsort (candidates->begin, SIZE (*candidates), sizeof (struct clause *),
-	 cmp_reduce_candidates);
+#define SIMPLIFIER(NAME,COUNT,PASS,TYPE) \
+  if (solver->limits.NAME.conflicts <= CONFLICTS) \
+    return true;
+  SIMPLIFIERS
+#undef SIMPLIFIER
+  return false;
 }
 
+// Run the first pass which is due at the root-level.  The other passes
+// which are due are run in the next calls, after propagating the units
+// found by this one.
+
 static void
-mark_garbage_candidates (struct satch *solver, struct clauses *candidates)
+simplify (struct satch *solver)
 {
-  const size_t size = SIZE (*candidates);
-  const size_t target = (1 - reduce_fraction) * size;
-
-  while (SIZE (*candidates) > target)
-    {
-      struct clause *c = POP (*candidates);
-      LOGCLS (c, "reducing thus marked garbage");
-      assert (!c->protected);
-      assert (!c->garbage);
-      c->garbage = true;
+  if (solver->level)
+    backtrack (solver, 0);
+
+#define SIMPLIFIER(NAME,COUNT,PASS,TYPE) \
+  if (solver->limits.NAME.conflicts <= CONFLICTS) \
+    { \
+      START (NAME); \
+      const uint64_t count = INC (COUNT); \
+      const uint64_t delta = TICKS - solver->limits.NAME.ticks; \
+      uint64_t effort = NAME ## _effort * delta; \
+      if (effort < NAME ## _min_effort) \
+	effort = NAME ## _min_effort; \
+      PASS (solver, effort); \
+      solver->limits.NAME.ticks = TICKS; \
+      const uint64_t interval = NAME ## _interval * ndivlogn (count); \
+      solver->limits.NAME.conflicts = CONFLICTS + interval; \
+      LOG ("next " #NAME " limit at %" PRIu64 \
+	   " conflicts after %" PRIu64, \
+	   solver->limits.NAME.conflicts, interval); \
+      STOP (NAME); \
+      report (solver, TYPE); \
+      return; \
     }
+  SIMPLIFIERS
+#undef SIMPLIFIER
 }
 
-static void
-reduce (struct satch *solver)
-{
-  const uint64_t reductions = INC (reductions);
-
-  assert (solver->statistics.redundant == SIZE (solver->redundant));
-  assert (solver->statistics.irredundant == SIZE (solver->irredundant));
-
-  set_protect_flag_of_reasons (solver, true);
-
-  const bool new_fixed_variables =
-    solver->limits.reduce.fixed < solver->statistics.fixed;
-  if (new_fixed_variables)
-    mark_satisfied_irredundant_clauses_as_garbage (solver);
-
-  struct clauses candidates;
-  INIT (candidates);
-  gather_reduce_candidates (solver, new_fixed_variables, &candidates);
-  sort_reduce_candidates (solver, &candidates);
-  mark_garbage_candidates (solver, &candidates);
-  RELEASE (candidates);
-
-  flush_garbage_watches (solver);
+#endif
 
-  size_t bytes = 0, count = 0;
-  if (new_fixed_variables)
-    delete_garbage_clauses (solver, &solver->irredundant, &bytes, &count);
-  delete_garbage_clauses (solver, &solver->redundant, &bytes, &count);
+/*------------------------------------------------------------------------*/
 
-  set_protect_flag_of_reasons (solver, false);
+#ifndef NMODE
 
-  solver->limits.reduce.fixed = solver->statistics.fixed;
+// Adaptive mode switching measures the progress per tick in each mode and
+// gives stable mode more or less ticks than the preceding focused mode
+// depending on which mode performed better recently on this instance.
+// Progress of a mode phase combines new root-level fixed variables, the
+// number of learned clauses weighted by their average glue and the
+// maximum trail size at conflicts relative to the number of variables.
+// The ratio is bounded by 'mode_min_factor' and 'mode_max_factor' such
+// that no mode is starved.
 
-  const uint64_t interval = reduce_interval * ndivlogn (reductions);
-  solver->limits.reduce.conflicts = CONFLICTS + interval;
+static void
+start_progress (struct satch *solver)
+{
+  solver->limits.mode.progress.ticks = TICKS;
+  solver->limits.mode.progress.conflicts = CONFLICTS;
+  solver->limits.mode.progress.glue = 0;
+  solver->limits.mode.progress.fixed = solver->statistics.fixed;
+  solver->limits.mode.progress.trail = 0;
+}
 
-  LOG ("next reduce limit at %" PRIu64 " conflicts after %" PRIu64,
-       solver->limits.reduce.conflicts, interval);
+static double
+update_progress (struct satch *solver)
+{
+  const uint64_t ticks = TICKS - solver->limits.mode.progress.ticks;
+  const uint64_t conflicts =
+    CONFLICTS - solver->limits.mode.progress.conflicts;
+  if (!ticks || !conflicts)
+    return 0;
+  const unsigned fixed =
+    solver->statistics.fixed - solver->limits.mode.progress.fixed;
+  const double glue =
+    relative (solver->limits.mode.progress.glue, conflicts);
+  const double trail =
+    relative (solver->limits.mode.progress.trail, solver->size);
+  const double progress =
+    (1 + fixed) * trail * relative (conflicts, glue) / ticks;
+  double *const average = solver->averages.progress + solver->stable;
+  if (*average)
+    *average += mode_progress_alpha * (progress - *average);
+  else
+    *average = progress;
+  LOG ("%s mode progress %g average %g",
+       solver->stable ? "stable" : "focused", progress, *average);
+  return progress;
+}
 
-  message (solver, 2, "[reduced-%" PRIu64 "] "
-	   "collected %zu clauses (%zu bytes, %.0f MB)",
-	   reductions, count, bytes, bytes / (double) (10 << 20));
+// Factor of stable mode ticks with respect to focused mode ticks.
 
-  report (solver, '-');
+static double
+stable_mode_factor (struct satch *solver)
+{
+  if (!solver->options.adaptive_mode)
+    return 1;
+  const double focused = solver->averages.progress[0];
+  const double stable = solver->averages.progress[1];
+  if (!focused || !stable)
+    return 1;
+  double factor = stable / focused;
+  if (factor < mode_min_factor)
+    factor = mode_min_factor;
+  if (factor > mode_max_factor)
+    factor = mode_max_factor;
+  return factor;
 }
 
-#endif
+// The stable mode heuristics are selected by a multi-armed bandit (UCB1).
+// Each arm is a combination of the values of the 'BANDIT_OPTIONS'.  At
+// the start of each stable mode phase the arm with the largest upper
+// confidence bound is pulled and its option values are set (arms not
+// pulled yet come first).  At the end of the phase the options set by
+// the user are restored and the arm is rewarded with the progress per tick
+// of the phase relative to the average progress in focused mode, which
+// normalizes the reward to the unit interval and accounts for search
+// getting harder over time.
 
-/*------------------------------------------------------------------------*/
+static void
+pull_arm (struct satch *solver)
+{
+  struct bandit *const bandit = &solver->bandit;
+  unsigned arms = 1;
+#define BANDIT_OPTION(NAME) \
+  arms *= 2;
+  BANDIT_OPTIONS
+#undef BANDIT_OPTION
+  assert (arms <= MAX_ARMS);
+  const uint64_t pulls = bandit->pulls++;
+  unsigned best = 0;
+  double best_bound = -1;
+  for (unsigned arm = 0; arm != arms; arm++)
+    {
+      const uint64_t count = bandit->count[arm];
+      if (!count)
+	{
+	  best = arm;
+	  break;
+	}
+      const double mean = bandit->reward[arm] / count;
+      const double bound =
+	mean + sqrt (bandit_exploration * log (pulls) / count);
+      if (bound > best_bound)
+	best = arm, best_bound = bound;
+    }
+  bandit->arm = best;
+  bandit->count[best]++;
+  unsigned bit = 1;
+#define BANDIT_OPTION(NAME) \
+  bandit->saved.NAME = solver->options.NAME; \
+  solver->options.NAME = !!(best & bit); \
+  bit *= 2;
+  BANDIT_OPTIONS
+#undef BANDIT_OPTION
+  (void) bit;
+  message (solver, 2, "[bandit-%" PRIu64 "] pulled arm %u", pulls + 1, best);
+}
 
-#ifndef NMODE
+static void
+reward_arm (struct satch *solver, double progress)
+{
+  struct bandit *const bandit = &solver->bandit;
+  const double focused = solver->averages.progress[0];
+  const double reward = relative (progress, progress + focused);
+  const unsigned arm = bandit->arm;
+  bandit->reward[arm] += reward;
+  LOG ("rewarding arm %u with %g", arm, reward);
+#define BANDIT_OPTION(NAME) \
+  solver->options.NAME = bandit->saved.NAME;
+  BANDIT_OPTIONS
+#undef BANDIT_OPTION
+}
 
 static void
 start_mode (struct satch * solver)
 {
+  start_progress (solver);
+  if (solver->stable && solver->options.bandit)
+    pull_arm (solver);
   if (solver->stable)
     {
       START (stable);
@@ -2725,6 +5911,9 @@ start_mode (struct satch * solver)
 static void
 stop_mode (struct satch * solver)
 {
+  const double progress = update_progress (solver);
+  if (solver->stable && solver->options.bandit)
+    reward_arm (solver, progress);
   if (solver->stable)
     {
       STOP (stable);
@@ -2766,9 +5955,16 @@ switch_mode (struct satch *solver)
       solver->stable = true;
       assert (TICKS <= solver->statistics.ticks);
       const uint64_t focused_ticks = TICKS - solver->limits.mode.ticks;
-      solver->limits.mode.ticks = TICKS + focused_ticks;
+      const double factor = stable_mode_factor (solver);
+      const uint64_t stable_ticks = factor * focused_ticks;
+      message (solver, 2, "[switched-%" PRIu64 "] "
+	       "stable mode ticks %" PRIu64 " = %.2f * %" PRIu64
+	       " focused mode ticks", switched, stable_ticks, factor,
+	       focused_ticks);
+      solver->limits.mode.ticks = TICKS + stable_ticks;
       solver->limits.mode.restarts.inner = inner_interval;
       solver->limits.mode.restarts.outer = inner_interval;
+      solver->limits.mode.restarts.luby = 0;
     }
   start_mode (solver);
 }
@@ -2777,12 +5973,33 @@ switch_mode (struct satch *solver)
 
 /*------------------------------------------------------------------------*/
 
+static void
+init_options (struct satch *solver)
+{
+#define OPTION(NAME,DEFAULT,MIN,MAX,DESCRIPTION) \
+  solver->options.NAME = DEFAULT;
+  OPTIONS
+#undef OPTION
+  (void) solver;
+}
+
+/*------------------------------------------------------------------------*/
+
 static void
 init_limits (struct satch * solver)
 {
 #ifndef NREDUCE
   solver->limits.reduce.conflicts = reduce_interval;
 #endif
+#ifndef NBLOCKED
+  solver->limits.blocked.conflicts = 0;	// Before first decision.
+#endif
+#ifndef NTRANSITIVE
+  solver->limits.transitive.conflicts = 0;	// Before first decision.
+#endif
+#ifndef NCOMPACT
+  solver->limits.compact.conflicts = 0;	// Before first decision.
+#endif
 #ifndef NRESTART
   solver->limits.restart = restart_interval;
 #ifndef NMODE
@@ -2835,12 +6052,21 @@ solve (struct satch *solver)
 	    if (reducing (solver))
 	      reduce (solver);
 #endif
-	    decide (solver);
+#ifndef NSIMPLIFY
+	    if (simplifying (solver))
+	      simplify (solver);
+	    else
+#endif
+	      decide (solver);
 	  }
       }
 #ifndef NMODE
   stop_mode (solver);
 #endif
+#ifndef NBLOCKED
+  if (res == 10)
+    extend_witness (solver);
+#endif
 
   report (solver, !res ? '?' : res == 10 ? '1' : '0');
   STOP (solve);
@@ -2887,6 +6113,252 @@ check_witness (struct satch *solver)
 
 /*------------------------------------------------------------------------*/
 
+// Before solving we compute a few cheap syntactic features of the formula,
+// which are printed in verbose mode and can be exported in JSON format
+// through 'satch_write_features'.  The features are listed with the same
+// idiom as 'REPORTS' giving their name and print format.
+
+#define FEATURES \
+FEATURE (variables, "%.0f") \
+FEATURE (clauses, "%.0f") \
+FEATURE (ratio, "%.3f") \
+FEATURE (binary, "%.3f") \
+FEATURE (ternary, "%.3f") \
+FEATURE (size_average, "%.3f") \
+FEATURE (size_maximum, "%.0f") \
+FEATURE (degree_average, "%.3f") \
+FEATURE (degree_maximum, "%.0f") \
+FEATURE (degree_deviation, "%.3f") \
+FEATURE (xors, "%.0f") \
+FEATURE (at_most_one_pairs, "%.0f")
+
+struct features
+{
+#define FEATURE(NAME,FMT) \
+  double NAME;
+  FEATURES
+#undef FEATURE
+};
+
+// Clauses of size 'MAX_XOR_SIZE' or less are checked to be part of an XOR
+// constraint, which is the case if all the clauses with the same
+// variables and the same parity of negated literals occur.
+
+#define MAX_XOR_SIZE 4
+
+struct xor_candidate
+{
+  unsigned size;
+  unsigned signs;
+  unsigned idx[MAX_XOR_SIZE];
+};
+
+static int
+cmp_xor_candidates (const void *p, const void *q)
+{
+  const struct xor_candidate *c = p, *d = q;
+  if (c->size != d->size)
+    return c->size < d->size ? -1 : 1;
+  for (unsigned i = 0; i != c->size; i++)
+    if (c->idx[i] != d->idx[i])
+      return c->idx[i] < d->idx[i] ? -1 : 1;
+  if (c->signs != d->signs)
+    return c->signs < d->signs ? -1 : 1;
+  return 0;
+}
+
+static bool
+same_xor_variables (const struct xor_candidate *c,
+		    const struct xor_candidate *d)
+{
+  if (c->size != d->size)
+    return false;
+  for (unsigned i = 0; i != c->size; i++)
+    if (c->idx[i] != d->idx[i])
+      return false;
+  return true;
+}
+
+static size_t
+count_xors (struct xor_candidate *candidates, size_t size)
+{
+  qsort (candidates, size, sizeof *candidates, cmp_xor_candidates);
+  size_t xors = 0;
+  for (size_t i = 0, j; i < size; i = j)
+    {
+      unsigned count[2] = { 0, 0 };
+      unsigned last = INVALID;
+      for (j = i; j < size && same_xor_variables (candidates + i,
+						  candidates + j); j++)
+	{
+	  const unsigned signs = candidates[j].signs;
+	  if (signs == last)
+	    continue;
+	  unsigned parity = 0;
+	  for (unsigned tmp = signs; tmp; tmp &= tmp - 1)
+	    parity ^= 1;
+	  count[parity]++;
+	  last = signs;
+	}
+      const unsigned needed = 1u << (candidates[i].size - 1);
+      xors += (count[0] == needed) + (count[1] == needed);
+    }
+  return xors;
+}
+
+static void
+compute_features (struct satch *solver, struct features *features)
+{
+  memset (features, 0, sizeof *features);
+  uint64_t *degrees = calloc (VARIABLES + 1, sizeof *degrees);
+  if (!degrees)
+    out_of_memory ((VARIABLES + 1) * sizeof *degrees);
+  struct xor_candidate *candidates = 0;
+  size_t size_candidates = 0, capacity_candidates = 0;
+  uint64_t literals = 0;
+  for (all_irredundant_clauses (c))
+    {
+      const unsigned size = c->size;
+      features->clauses++;
+      literals += size;
+      if (size == 2)
+	{
+	  features->binary++;
+	  if (SIGN (c->literals[0]) && SIGN (c->literals[1]))
+	    features->at_most_one_pairs++;
+	}
+      else if (size == 3)
+	features->ternary++;
+      if (size > features->size_maximum)
+	features->size_maximum = size;
+      for (all_literals_in_clause (lit, c))
+	degrees[INDEX (lit)]++;
+      if (size < 3 || size > MAX_XOR_SIZE)
+	continue;
+      if (size_candidates == capacity_candidates)
+	{
+	  capacity_candidates = capacity_candidates ?
+	    2 * capacity_candidates : 1;
+	  const size_t bytes = capacity_candidates * sizeof *candidates;
+	  candidates = realloc (candidates, bytes);
+	  if (!candidates)
+	    out_of_memory (bytes);
+	}
+      struct xor_candidate *candidate = candidates + size_candidates++;
+      candidate->size = size;
+      candidate->signs = 0;
+      for (unsigned i = 0; i != size; i++)	// insertion sort
+	{
+	  const unsigned lit = c->literals[i];
+	  unsigned j = i, idx = INDEX (lit), sign = SIGN (lit);
+	  for (; j && candidate->idx[j - 1] > idx; j--)
+	    candidate->idx[j] = candidate->idx[j - 1];
+	  candidate->idx[j] = idx;
+	  const unsigned high = candidate->signs >> j;
+	  const unsigned low = candidate->signs & ((1u << j) - 1);
+	  candidate->signs = (high << (j + 1)) | (sign << j) | low;
+	}
+    }
+  features->xors = count_xors (candidates, size_candidates);
+  free (candidates);
+
+  double sum = 0, squares = 0;
+  for (all_variables (idx))
+    {
+      const uint64_t degree = degrees[idx];
+      if (!degree)
+	continue;
+      features->variables++;
+      sum += degree;
+      squares += degree * (double) degree;
+      if (degree > features->degree_maximum)
+	features->degree_maximum = degree;
+    }
+  free (degrees);
+
+  const double variables = features->variables;
+  const double clauses = features->clauses;
+  features->ratio = relative (clauses, variables);
+  features->binary = relative (features->binary, clauses);
+  features->ternary = relative (features->ternary, clauses);
+  features->size_average = relative (literals, clauses);
+  features->degree_average = relative (sum, variables);
+  const double average = features->degree_average;
+  const double variance = relative (squares, variables) - average * average;
+  features->degree_deviation = variance > 0 ? sqrt (variance) : 0;
+}
+
+static void
+print_features (struct satch *solver, struct features *features)
+{
+  section (solver, "features");
+#define FEATURE(NAME,FMT) \
+  printf ("c %-27s " FMT "\n", #NAME ":", features->NAME);
+  FEATURES
+#undef FEATURE
+  fflush (stdout);
+}
+
+// The following hand-written rules select run-time options based on the
+// features (if 'auto_config' is enabled).  They overwrite options set by
+// the user and only use options enabled at compile time.
+
+#define RULES \
+RULE_IF_MODE (ternary > 0.9 && ratio < 4.2, target_phases, 1, \
+  "under-constrained 3-SAT, likely satisfiable") \
+RULE_IF_MODE (xors > 0.1 * clauses, stable_restarts, 1, \
+  "many XOR constraints") \
+RULE_IF_BUMPREASONS (size_average > 10, bump_reasons, 0, \
+  "long clauses make reason side bumping expensive")
+
+#define DO_NOT_RULE(CONDITION,OPTION,VALUE,DESCRIPTION) /**/
+#ifdef NMODE
+#define RULE_IF_MODE DO_NOT_RULE
+#else
+#define RULE_IF_MODE RULE
+#endif
+#ifdef NBUMPREASONS
+#define RULE_IF_BUMPREASONS DO_NOT_RULE
+#else
+#define RULE_IF_BUMPREASONS RULE
+#endif
+
+static void
+auto_config (struct satch *solver, struct features *features)
+{
+  const double clauses = features->clauses;
+  const double ratio = features->ratio;
+  const double size_average = features->size_average;
+  const double ternary = features->ternary;
+  const double xors = features->xors;
+#define RULE(CONDITION,OPTION,VALUE,DESCRIPTION) \
+  if (CONDITION) \
+    { \
+      message (solver, 1, "auto-config '%s=%d' (%s)", \
+	       #OPTION, VALUE, DESCRIPTION); \
+      solver->options.OPTION = VALUE; \
+    }
+  RULES
+#undef RULE
+  (void) clauses, (void) ratio, (void) size_average;
+  (void) ternary, (void) xors;
+}
+
+static void
+features_before_solving (struct satch *solver)
+{
+  if (!solver->options.verbose && !solver->options.auto_config)
+    return;			// Features are only needed for these.
+  struct features features;
+  compute_features (solver, &features);
+  if (solver->options.verbose)
+    print_features (solver, &features);
+  if (solver->options.auto_config)
+    auto_config (solver, &features);
+}
+
+/*------------------------------------------------------------------------*/
+
 // The API functions below have several requirements (contracts) and those
 // need to be enforced even in optimized code, particularly in order to help
 // library users to detect, test and debug wrong API usage.
@@ -2938,6 +6410,7 @@ satch_init (void)
 #endif
   init_averages (solver);
   init_limits (solver);
+  init_options (solver);
   init_profiles (solver);
   return solver;
 }
@@ -2950,23 +6423,20 @@ satch_release (struct satch *solver)
   if (solver->level)
     backtrack (solver, 0);	// To delete reason clauses.
 #endif
-  free (solver->levels);
-  free (solver->links);
-  free (solver->values);
-  free (solver->saved);
-  free (solver->marks);
-  free (solver->frames);
-  free (solver->reasons);
-  free (solver->trail.begin);
   for (all_literals (lit))
     RELEASE (solver->watches[lit]);
-  free (solver->watches);
 #ifndef NMINIMIZE
   RELEASE (solver->marked);
 #endif
   RELEASE (solver->seen);
   RELEASE (solver->clause);
+#ifdef COMPRESS
+  RELEASE (solver->decoded);
+#endif
   RELEASE (solver->blocks);
+#ifndef NBLOCKED
+  RELEASE (solver->extension);
+#endif
   for (all_pointers_on_stack (struct clause, c, solver->irredundant))
       (void) delete_clause (solver, c);
   RELEASE (solver->irredundant);
@@ -2977,6 +6447,17 @@ satch_release (struct satch *solver)
 #endif
   assert (!solver->statistics.irredundant);
   assert (!solver->statistics.redundant);
+#ifndef NREDUCE
+  release_arena_blocks (&solver->arena.blocks);
+#endif
+#ifndef NSPILL
+  if (solver->spill.file)
+    fclose (solver->spill.file);
+#endif
+  release_variable_arrays (solver);	// After 'delete_clause' (checking).
+  RELEASE (solver->imports);
+  free (solver->table);
+  release_fingerprints (solver);
 #ifndef NDEBUG
   RELEASE (solver->added);
   RELEASE (solver->original);
@@ -2987,16 +6468,30 @@ satch_release (struct satch *solver)
 
 /*------------------------------------------------------------------------*/
 
+// Propagate root-level units during import and return 'false' if this
+// results in a conflict, in which case the formula is inconsistent.
+
+static bool
+propagate_imported_units (struct satch *solver)
+{
+  assert (!solver->level);
+  if (!boolean_constraint_propagation (solver))
+    return true;
+  LOG ("propagating imported units yields conflict");
+  solver->inconsistent = true;
+#ifndef NDEBUG
+  checker_learned (solver->checker);
+#endif
+  return false;
+}
+
 // Add a literal to an internal temporary clause or if the literal argument
 // is zero then add a new irredundant / original clause to the solver which
 // consists of all the previously literals added to the temporary clause.
 
-void
-satch_add (struct satch *solver, int elit)
+static void
+add_literal (struct satch *solver, int elit)
 {
-  REQUIRE_NON_ZERO_SOLVER ();
-  REQUIRE_VALID_LITERAL (elit);
-  REQUIRE (!solver->status, "incremental usage not implemented yet");
 #ifndef NDEBUG
   PUSH (solver->original, elit);
 #endif
@@ -3006,6 +6501,16 @@ satch_add (struct satch *solver, int elit)
 
   if (elit)
     {
+      // Root-level units assigned while importing previous clauses (or
+      // implied by them) are propagated lazily at the start of the next
+      // clause.  Thus imported clauses satisfied by implied literals are
+      // not allocated at all and falsified literals are removed.
+      //
+      if (EMPTY (solver->clause) &&
+	  solver->trail.propagate != solver->trail.end &&
+	  !propagate_imported_units (solver))
+	return;
+
       // Add the literal to internal temporary 'clause' after importing the
       // literal, i.e., adjusting the 'size' (number of active variables) if
       // its variable has never been seen before.  Also turn the external
@@ -3014,8 +6519,9 @@ satch_add (struct satch *solver, int elit)
       const unsigned ilit = import_literal (solver, elit);
       PUSH (solver->clause, ilit);
 #ifndef NDEBUG
-      checker_add (solver->checker, elit);
-      PUSH (solver->added, elit);
+      const int clit = export_literal (solver, ilit);
+      checker_add (solver->checker, clit);
+      PUSH (solver->added, clit);
 #endif
     }
   else
@@ -3053,7 +6559,7 @@ satch_add (struct satch *solver, int elit)
 	      // situation of deleting unit clauses in RUP / DRAT proofs).
 
 	      const unsigned unit = ACCESS (solver->clause, 0);
-	      const signed char value = solver->values[unit];
+	      const signed char value = literal_value (solver->values, unit);
 	      if (value > 0)
 		{
 		  LOG ("skipping redundant unit clause %u", unit);
@@ -3069,11 +6575,19 @@ satch_add (struct satch *solver, int elit)
 		  assign (solver, unit, 0);
 		}
 	    }
+	  else if (solver->options.deduplicate &&
+		   imported_clause_duplicated (solver))
+	    {
+	      LOG ("skipping duplicated imported clause");
+	      INC (deduplicated);
+	    }
 	  else
 	    {
 	      struct clause *clause = new_irredundant_clause (solver);
 	      LOGCLS (clause, "imported");
 	      watch_clause (solver, clause);
+	      if (solver->options.deduplicate)
+		fingerprint_imported_clause (solver, clause);
 	    }
 #ifndef NDEBUG
 	  const size_t added = SIZE (solver->added);
@@ -3081,7 +6595,7 @@ satch_add (struct satch *solver, int elit)
 	  if (size < added)
 	    {
 	      for (all_elements_on_stack (unsigned, lit, solver->clause))
-		checker_add (solver->checker, export_literal (lit));
+		checker_add (solver->checker, export_literal (solver, lit));
 	      checker_learned (solver->checker);
 
 	      remove_original_clause_from_checker = true;
@@ -3107,6 +6621,31 @@ satch_add (struct satch *solver, int elit)
     }
 }
 
+void
+satch_add (struct satch *solver, int elit)
+{
+  REQUIRE_NON_ZERO_SOLVER ();
+  REQUIRE_VALID_LITERAL (elit);
+  REQUIRE (!solver->status, "incremental usage not implemented yet");
+  add_literal (solver, elit);
+}
+
+// Bulk version of 'satch_add' which checks the solver state only once.
+
+void
+satch_add_literals (struct satch *solver, size_t size, const int *literals)
+{
+  REQUIRE_NON_ZERO_SOLVER ();
+  REQUIRE (!solver->status, "incremental usage not implemented yet");
+  const int *const end = literals + size;
+  for (const int *p = literals; p != end; p++)
+    {
+      const int elit = *p;
+      REQUIRE_VALID_LITERAL (elit);
+      add_literal (solver, elit);
+    }
+}
+
 /*------------------------------------------------------------------------*/
 
 // Reserve at least 'max_var' variables that is the size of the solver. If
@@ -3127,8 +6666,24 @@ int
 satch_maximum_variable (struct satch *solver)
 {
   REQUIRE_NON_ZERO_SOLVER ();
-  assert (solver->size <= (unsigned) INT_MAX);
-  return solver->size;
+  return solver->maximum;
+}
+
+int
+satch_imported_variables (struct satch *solver)
+{
+  REQUIRE_NON_ZERO_SOLVER ();
+  assert (SIZE (solver->imports) <= (unsigned) INT_MAX);
+  return SIZE (solver->imports);
+}
+
+int
+satch_imported_variable (struct satch *solver, int position)
+{
+  REQUIRE_NON_ZERO_SOLVER ();
+  REQUIRE (0 <= position && (size_t) position < SIZE (solver->imports),
+	   "invalid imported variable position");
+  return ACCESS (solver->imports, position).external;
 }
 
 /*------------------------------------------------------------------------*/
@@ -3137,7 +6692,9 @@ satch_maximum_variable (struct satch *solver)
 // 'elit' if it is assigned to 'true'.  Otherwise it returns zero.  We do
 // not want to use 'import_literal' here, since this forces to adapt the
 // size (and capacity) of the solver to this literal even though it did not
-// occur in a clause yet.  So we have to do that importing manually.
+// occur in a clause yet.  So we have to do that importing manually.  Note
+// that root-level fixed variables removed by 'compact_variables' are mapped
+// to the same (fixed) internal literal or its negation.
 
 int
 satch_val (struct satch *solver, int elit)
@@ -3147,11 +6704,10 @@ satch_val (struct satch *solver, int elit)
   int eidx = abs (elit);
   assert (eidx > 0);
   assert (eidx != INT_MIN);
-  const unsigned iidx = eidx - 1;
-  if (iidx >= solver->size)
+  const unsigned ilit = imported_literal (solver, eidx);
+  if (ilit == INVALID)
     return 0;
-  const unsigned ilit = LITERAL (iidx);
-  signed char tmp = solver->values[ilit];
+  signed char tmp = literal_value (solver->values, ilit);
   if (!tmp)
     return 0;
   int res = (tmp > 0) ? elit : -elit;
@@ -3168,6 +6724,8 @@ satch_solve (struct satch *solver)
   REQUIRE (EMPTY (solver->clause),
 	   "incomplete clause (zero literal missing)");
   REQUIRE (!solver->status, "no incremental solving yet");
+  release_fingerprints (solver);	// Clauses are moved during solving.
+  features_before_solving (solver);
   if (solver->options.verbose)
     section (solver, "solving");
   int res = solve (solver);
@@ -3205,6 +6763,79 @@ satch_enable_logging_messages (struct satch *solver)
 
 /*------------------------------------------------------------------------*/
 
+int
+satch_set_option (struct satch *solver, const char *name, int value)
+{
+  REQUIRE_NON_ZERO_SOLVER ();
+  REQUIRE (name, "zero option name argument");
+#define OPTION(NAME,DEFAULT,MIN,MAX,DESCRIPTION) \
+  if (!strcmp (name, #NAME)) \
+    { \
+      if (value < MIN) \
+	value = MIN; \
+      if (value > MAX) \
+	value = MAX; \
+      solver->options.NAME = value; \
+      return 1; \
+    }
+  OPTIONS
+#undef OPTION
+  return 0;
+}
+
+int
+satch_get_option (struct satch *solver, const char *name)
+{
+  REQUIRE_NON_ZERO_SOLVER ();
+  REQUIRE (name, "zero option name argument");
+#define OPTION(NAME,DEFAULT,MIN,MAX,DESCRIPTION) \
+  if (!strcmp (name, #NAME)) \
+    return solver->options.NAME;
+  OPTIONS
+#undef OPTION
+  return INT_MIN;
+}
+
+void
+satch_usage_options (void)
+{
+  char buffer[64];
+#define OPTION(NAME,DEFAULT,MIN,MAX,DESCRIPTION) \
+  do { \
+    char *p = buffer; \
+    p += sprintf (p, "--"); \
+    for (const char *q = #NAME; *q; q++) \
+      *p++ = (*q == '_') ? '-' : *q; \
+    sprintf (p, "=%d..%d", MIN, MAX); \
+    printf ("  %-26s %s [%d]\n", buffer, DESCRIPTION, DEFAULT); \
+  } while (0);
+  OPTIONS
+#undef OPTION
+  (void) buffer;
+}
+
+int
+satch_write_features (struct satch *solver, const char *path)
+{
+  REQUIRE_NON_ZERO_SOLVER ();
+  REQUIRE (path, "zero path argument");
+  struct features features;
+  compute_features (solver, &features);
+  FILE *file = fopen (path, "w");
+  if (!file)
+    return 0;
+  const char *separator = "{\n";
+#define FEATURE(NAME,FMT) \
+  fprintf (file, "%s  \"%s\": " FMT, separator, #NAME, features.NAME); \
+  separator = ",\n";
+  FEATURES
+#undef FEATURE
+  fputs ("\n}\n", file);
+  return !fclose (file);
+}
+
+/*------------------------------------------------------------------------*/
+
 double
 satch_process_time (void)
 {
@@ -1,6 +1,8 @@
 #ifndef _satch_h_INCLUDED
 #define _satch_h_INCLUDED
 
+#include <stddef.h>
+
 /*------------------------------------------------------------------------*/
 
 // SAT competition conformant exit codes also use for 'satch_solve'.
@@ -26,14 +28,27 @@ int satch_val (struct satch *, int);	// Get value of literal.
 
 // Additional API functions.
 
+// Add 'size' literals as if 'satch_add' is called for each of them in
+// turn (including terminating zeroes), but with less overhead.
+//
+void satch_add_literals (struct satch *, size_t size, const int *literals);
+
 // Allocate and activate the given number of variables.
 //
 void satch_reserve (struct satch *, int max_var);
 
-// Return the largest active variable.
+// Return the largest imported (external) variable.
 //
 int satch_maximum_variable (struct satch *);
 
+// External variables can be sparse.  These two functions allow to iterate
+// over the imported variables (in the order they were imported), i.e., the
+// variables which occurred in added clauses, with 'position' ranging from
+// zero to the number of imported variables minus one.
+//
+int satch_imported_variables (struct satch *);
+int satch_imported_variable (struct satch *, int position);
+
 // By default the library does not print any messages (the binary however
 // does switch on 'verbose' messages by default unless '-q' is specified)
 // There are currently four non-zero levels of verbose messages.
@@ -44,6 +59,25 @@ void satch_set_verbose_level (struct satch *, int level);
 void satch_enable_logging_messages (struct satch *);
 #endif
 
+// Set run-time option value (clipped to its range).  The option name uses
+// underscores as in 'restart_blocking'.  Returns zero if the option does
+// not exist (also if disabled at compile time) and non-zero otherwise.
+//
+int satch_set_option (struct satch *, const char *name, int value);
+
+// Get run-time option value or 'INT_MIN' if the option does not exist.
+//
+int satch_get_option (struct satch *, const char *name);
+
+// Print run-time options in the format of the stand-alone solver.
+//
+void satch_usage_options (void);
+
+// Write the syntactic features of the current formula in JSON format to
+// the given file.  Returns zero if the file could not be written.
+//
+int satch_write_features (struct satch *, const char *path);
+
 // Get process time used by the current process.
 //
 double satch_process_time (void);
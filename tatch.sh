@@ -118,6 +118,31 @@ run 20 ./satch cnfs/add64.cnf
 run 20 ./satch cnfs/add128.cnf
 fi
 
+msg "solving with run-time options"
+run 10 ./satch --auto-config cnfs/sqrt63001.cnf
+run 20 ./satch --reserve-memory cnfs/add16.cnf
+run 20 ./satch --huge-pages cnfs/add16.cnf
+run 20 ./satch --huge-pages --reserve-memory cnfs/add16.cnf
+run 20 ./satch --deduplicate cnfs/add16.cnf
+if [ x"`grep DNRESTART makefile`" = x ]
+then
+run 20 ./satch --no-restart-blocking cnfs/add16.cnf
+if [ x"`grep DNMODE makefile`" = x ]
+then
+run 10 ./satch --stable-restarts=1 cnfs/sqrt63001.cnf
+run 10 ./satch --bandit cnfs/sqrt63001.cnf
+run 10 ./satch --target-phases cnfs/sqrt63001.cnf
+fi
+fi
+if [ x"`grep -e DNREDUCE -e DNLEARN makefile`" = x ]
+then
+run 20 ./satch --no-reorder-clauses cnfs/add16.cnf
+if [ x"`grep DNCOMPACT makefile`" = x ]
+then
+run 20 ./satch --spill-clauses cnfs/prime65537.cnf
+fi
+fi
+
 msg "compiling 'testapi.c' and linking against library"
 
 compiler="`grep ^COMPILE makefile|sed 's,^COMPILE=,,'`"
@@ -141,3 +166,19 @@ echo $compile
 $compile || exit 1
 run 0 ./testapi
 
+if [ ! x"`grep DCOMPRESS makefile`" = x ]
+then
+msg "compiling checking solver compressing almost all learned clauses"
+compile="$compiler -Dcompress_size=3 -Dcompress_plain=2"
+compile="$compile -o compress main.c satch.c catch.c config.c -lm"
+echo $compile
+$compile || exit 1
+run 20 ./compress cnfs/add16.cnf
+run 20 ./compress cnfs/add32.cnf
+run 10 ./compress cnfs/sqrt63001.cnf
+if [ x"`grep DNCOMPACT makefile`" = x ]
+then
+run 20 ./compress --spill-clauses cnfs/prime65537.cnf
+fi
+fi
+
@@ -1,4 +1,5 @@
 #include "satch.h"
+#include <limits.h>
 #include <stdio.h>
 #include <stdlib.h>
 #undef NDEBUG
@@ -35,5 +36,83 @@ main (void)
     assert (res == 20);
     satch_release (solver);
   }
+  {
+    struct satch *solver = satch_init ();
+    satch_add (solver, -1), satch_add (solver, 2), satch_add (solver, 0);
+    satch_add (solver, 1), satch_add (solver, 0);
+    satch_add (solver, -2), satch_add (solver, 3), satch_add (solver, 0);
+    satch_add (solver, 2), satch_add (solver, -4), satch_add (solver, 0);
+    satch_add (solver, -3), satch_add (solver, 4), satch_add (solver, 0);
+    int res = satch_solve (solver);
+    assert (res == 10);
+    assert (satch_val (solver, 3) == 3);
+    assert (satch_val (solver, 4) == 4);
+    satch_release (solver);
+  }
+  {
+    struct satch *solver = satch_init ();
+    satch_add (solver, -1), satch_add (solver, 2), satch_add (solver, 0);
+    satch_add (solver, 1), satch_add (solver, 0);
+    satch_add (solver, -2), satch_add (solver, 0);
+    int res = satch_solve (solver);
+    assert (res == 20);
+    satch_release (solver);
+  }
+  {
+    struct satch *solver = satch_init ();
+    satch_add (solver, 2000000000), satch_add (solver, -7), satch_add (solver, 0);
+    satch_add (solver, -2000000000), satch_add (solver, 0);
+    int res = satch_solve (solver);
+    assert (res == 10);
+    assert (satch_maximum_variable (solver) == 2000000000);
+    assert (satch_imported_variables (solver) == 2);
+    assert (satch_imported_variable (solver, 0) == 2000000000);
+    assert (satch_imported_variable (solver, 1) == 7);
+    assert (satch_val (solver, 2000000000) == -2000000000);
+    assert (satch_val (solver, -7) == -7);
+    assert (!satch_val (solver, 3));
+    satch_release (solver);
+  }
+  {
+    struct satch *solver = satch_init ();
+    const int literals[] = { 1, 2, 0, -1, 0, 3, 0, 0 };
+    satch_add_literals (solver, 6, literals);
+    satch_add_literals (solver, 0, literals);
+    satch_add_literals (solver, 1, literals + 6);
+    int res = satch_solve (solver);
+    assert (res == 10);
+    assert (satch_val (solver, 2) == 2);
+    assert (satch_val (solver, 3) == 3);
+    satch_release (solver);
+  }
+  {
+    struct satch *solver = satch_init ();
+    int res = satch_set_option (solver, "deduplicate", 1);
+    assert (res);
+    satch_add (solver, 1), satch_add (solver, 2), satch_add (solver, 0);
+    satch_add (solver, 2), satch_add (solver, 1), satch_add (solver, 0);
+    satch_add (solver, 2), satch_add (solver, 1), satch_add (solver, 2);
+    satch_add (solver, 0);
+    satch_add (solver, -1), satch_add (solver, 0);
+    satch_add (solver, -2), satch_add (solver, 0);
+    res = satch_solve (solver);
+    assert (res == 20);
+    satch_release (solver);
+  }
+  {
+    struct satch *solver = satch_init ();
+    int res = satch_set_option (solver, "no_such_option", 1);
+    assert (!res);
+    res = satch_get_option (solver, "no_such_option");
+    assert (res == INT_MIN);
+    if (satch_get_option (solver, "restart_blocking") != INT_MIN)
+      {
+	res = satch_set_option (solver, "restart_blocking", 2);
+	assert (res);
+	res = satch_get_option (solver, "restart_blocking");
+	assert (res == 1);
+      }
+    satch_release (solver);
+  }
   return 0;
 }